@@ -0,0 +1,312 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+// Ordered index over (salary, employee id) pairs, laid out like a two-level
+// B+-tree: leaves are sorted blocks of at most 2 * BlockSize entries stored
+// contiguously, and the top level is the sorted list of each block's first
+// entry. A Fenwick tree over the block sizes turns "how many entries come
+// before block b" into an O(log blocks) query, so range counts are
+// O(log n) and range listings are O(log n + k).
+class SalaryIndex {
+public:
+    struct Entry {
+        double salary;
+        int employeeID;
+
+        bool operator<(const Entry& o) const {
+            return salary < o.salary || (salary == o.salary && employeeID < o.employeeID);
+        }
+        bool operator==(const Entry& o) const { return salary == o.salary && employeeID == o.employeeID; }
+    };
+
+private:
+    static constexpr size_t BlockSize = 256;
+
+    vector<vector<Entry>> blocks;
+    vector<Entry> firsts;     // firsts[b] == blocks[b].front()
+    vector<size_t> fenwick;   // 1-based Fenwick tree of block sizes
+    size_t total = 0;
+
+    void rebuildTopLevel() {
+        firsts.clear();
+        fenwick.assign(blocks.size() + 1, 0);
+        for (size_t b = 0; b < blocks.size(); ++b) {
+            firsts.push_back(blocks[b].front());
+            for (size_t i = b + 1; i <= blocks.size(); i += i & (~i + 1)) {
+                fenwick[i] += blocks[b].size();
+            }
+        }
+    }
+
+    void addToBlockCount(size_t b, long delta) {
+        for (size_t i = b + 1; i < fenwick.size(); i += i & (~i + 1)) {
+            fenwick[i] = size_t(long(fenwick[i]) + delta);
+        }
+    }
+
+    // Entries in blocks [0, b).
+    size_t entriesBefore(size_t b) const {
+        size_t sum = 0;
+        for (size_t i = b; i > 0; i -= i & (~i + 1)) {
+            sum += fenwick[i];
+        }
+        return sum;
+    }
+
+    // Block that does or would contain 'e'.
+    size_t blockFor(const Entry& e) const {
+        size_t b = size_t(upper_bound(firsts.begin(), firsts.end(), e) - firsts.begin());
+        return b == 0 ? 0 : b - 1;
+    }
+
+    // Number of entries with salary < s (or <= s when 'inclusive').
+    size_t countBelow(double s, bool inclusive) const {
+        auto before = [&](const Entry& e) { return inclusive ? e.salary <= s : e.salary < s; };
+        // Blocks are in order, so 'before' holds for a prefix of them and,
+        // inside the first block where it stops holding, for a prefix of entries.
+        size_t b = size_t(partition_point(firsts.begin(), firsts.end(), before) - firsts.begin());
+        if (b == 0) {
+            return 0;
+        }
+        const vector<Entry>& block = blocks[b - 1];
+        return entriesBefore(b - 1) + size_t(partition_point(block.begin(), block.end(), before) - block.begin());
+    }
+
+public:
+    // Bulk build from unsorted entries: O(n log n).
+    void build(vector<Entry> entries) {
+        sort(entries.begin(), entries.end());
+        blocks.clear();
+        for (size_t i = 0; i < entries.size(); i += BlockSize) {
+            blocks.emplace_back(entries.begin() + ptrdiff_t(i),
+                                entries.begin() + ptrdiff_t(min(entries.size(), i + BlockSize)));
+        }
+        total = entries.size();
+        rebuildTopLevel();
+    }
+
+    size_t size() const { return total; }
+
+    void insert(double salary, int employeeID) {
+        Entry e{salary, employeeID};
+        if (blocks.empty()) {
+            blocks.push_back({e});
+            total = 1;
+            rebuildTopLevel();
+            return;
+        }
+        size_t b = blockFor(e);
+        vector<Entry>& block = blocks[b];
+        block.insert(upper_bound(block.begin(), block.end(), e), e);
+        ++total;
+        if (block.size() > 2 * BlockSize) {
+            // Split the full leaf in two; the top level changes shape.
+            vector<Entry> upper(block.begin() + ptrdiff_t(BlockSize), block.end());
+            block.resize(BlockSize);
+            blocks.insert(blocks.begin() + ptrdiff_t(b + 1), move(upper));
+            rebuildTopLevel();
+        } else {
+            firsts[b] = block.front();
+            addToBlockCount(b, +1);
+        }
+    }
+
+    bool erase(double salary, int employeeID) {
+        Entry e{salary, employeeID};
+        if (blocks.empty()) {
+            return false;
+        }
+        size_t b = blockFor(e);
+        vector<Entry>& block = blocks[b];
+        auto it = lower_bound(block.begin(), block.end(), e);
+        if (it == block.end() || !(*it == e)) {
+            return false;
+        }
+        block.erase(it);
+        --total;
+        if (block.empty()) {
+            blocks.erase(blocks.begin() + ptrdiff_t(b));
+            rebuildTopLevel();
+        } else {
+            firsts[b] = block.front();
+            addToBlockCount(b, -1);
+        }
+        return true;
+    }
+
+    // Number of employees with lo <= salary <= hi.
+    size_t countInRange(double lo, double hi) const {
+        if (!(lo <= hi)) {
+            return 0;
+        }
+        return countBelow(hi, true) - countBelow(lo, false);
+    }
+
+    // Employee ids with lo <= salary <= hi, in salary order.
+    vector<int> listInRange(double lo, double hi) const {
+        vector<int> ids;
+        if (!(lo <= hi)) {
+            return ids;
+        }
+        auto below = [&](const Entry& e) { return e.salary < lo; };
+        size_t b = size_t(partition_point(firsts.begin(), firsts.end(), below) - firsts.begin());
+        b = b == 0 ? 0 : b - 1;
+        for (; b < blocks.size(); ++b) {
+            auto it = partition_point(blocks[b].begin(), blocks[b].end(), below);
+            for (; it != blocks[b].end(); ++it) {
+                if (it->salary > hi) {
+                    return ids;
+                }
+                ids.push_back(it->employeeID);
+            }
+        }
+        return ids;
+    }
+};
+
+// Employee as in 2_accessModifiers_Getters_Setters.cpp, but salary changes go
+// through Workforce so the index can never drift from the records. The
+// friend declaration is what lets Workforce, and only Workforce, write the
+// private salary (see 4_friend_class.cpp).
+class Employee {
+private:
+    string name;
+    int employeeID;
+    double salary;
+
+    friend class Workforce;
+
+public:
+    Employee(string empName, int empID, double empSalary)
+        : name(move(empName)), employeeID(empID), salary(empSalary >= 0 ? empSalary : 0) {}
+
+    const string& getName() const { return name; }
+    int getEmployeeID() const { return employeeID; }
+    double getSalary() const { return salary; }
+};
+
+class Workforce {
+private:
+    vector<Employee> staff;
+    unordered_map<int, size_t> rowOf;
+    SalaryIndex bySalary;
+
+public:
+    // Refuses an id that is already on staff; replacing the record would
+    // leave its old salary behind in the index.
+    bool hire(Employee e) {
+        if (!rowOf.try_emplace(e.getEmployeeID(), staff.size()).second) {
+            return false;
+        }
+        bySalary.insert(e.getSalary(), e.getEmployeeID());
+        staff.push_back(move(e));
+        return true;
+    }
+
+    // Bulk hire: one O(n log n) index rebuild instead of n inserts. Skips
+    // duplicate ids like hire() does; returns how many were hired.
+    size_t hireAll(vector<Employee> people) {
+        size_t before = staff.size();
+        for (Employee& e : people) {
+            if (rowOf.try_emplace(e.getEmployeeID(), staff.size()).second) {
+                staff.push_back(move(e));
+            }
+        }
+        vector<SalaryIndex::Entry> entries;
+        entries.reserve(staff.size());
+        for (const Employee& e : staff) {
+            entries.push_back({e.getSalary(), e.getEmployeeID()});
+        }
+        bySalary.build(move(entries));
+        return staff.size() - before;
+    }
+
+    // Same rule as Employee::setSalary; keeps the index in step.
+    bool setSalary(int employeeID, double newSalary) {
+        auto it = rowOf.find(employeeID);
+        if (it == rowOf.end() || !(newSalary >= 0)) {
+            return false;
+        }
+        Employee& e = staff[it->second];
+        bySalary.erase(e.salary, employeeID);
+        e.salary = newSalary;
+        bySalary.insert(newSalary, employeeID);
+        return true;
+    }
+
+    const vector<Employee>& employees() const { return staff; }
+    size_t countInBand(double lo, double hi) const { return bySalary.countInRange(lo, hi); }
+    vector<int> listBand(double lo, double hi) const { return bySalary.listInRange(lo, hi); }
+};
+
+size_t scanCount(const vector<Employee>& staff, double lo, double hi) {
+    size_t n = 0;
+    for (const Employee& e : staff) {
+        n += e.getSalary() >= lo && e.getSalary() <= hi;
+    }
+    return n;
+}
+
+int main(int argc, char* argv[]) {
+    Workforce team;
+    team.hire(Employee("Alice Smith", 1001, 60000.0));
+    team.hire(Employee("Bob Jones", 1002, 52000.0));
+    team.hire(Employee("Carol White", 1003, 71000.0));
+    team.hire(Employee("Bob Again", 1002, 30000.0)); // refused: id 1002 is taken
+    cout << "Between $50k and $65k: " << team.countInBand(50'000, 65'000) << endl;
+    team.setSalary(1003, 64000.0);
+    cout << "After Carol's change:  " << team.countInBand(50'000, 65'000) << " (ids:";
+    for (int id : team.listBand(50'000, 65'000)) {
+        cout << " " << id;
+    }
+    cout << ")" << endl;
+
+    // Usage: ./a.out [employees] [queries] [updates]
+    size_t n = argc > 1 ? stoull(argv[1]) : 2'000'000;
+    size_t queries = argc > 2 ? stoull(argv[2]) : 200;
+    size_t updates = argc > 3 ? stoull(argv[3]) : 200'000;
+
+    mt19937_64 rng(17);
+    uniform_real_distribution<double> pay(20'000, 250'000);
+    vector<Employee> people;
+    people.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        people.emplace_back("Employee " + to_string(i), int(i), round(pay(rng)));
+    }
+    Workforce company;
+    company.hireAll(move(people));
+
+    auto t0 = chrono::steady_clock::now();
+    for (size_t u = 0; u < updates; ++u) {
+        company.setSalary(int(rng() % n), round(pay(rng)));
+    }
+    auto t1 = chrono::steady_clock::now();
+
+    vector<pair<double, double>> bands(queries);
+    for (auto& [lo, hi] : bands) {
+        lo = pay(rng);
+        hi = lo + 5'000 + double(rng() % 20'000);
+    }
+    size_t indexed = 0, scanned = 0;
+    auto t2 = chrono::steady_clock::now();
+    for (auto [lo, hi] : bands) indexed += company.countInBand(lo, hi);
+    auto t3 = chrono::steady_clock::now();
+    for (auto [lo, hi] : bands) scanned += scanCount(company.employees(), lo, hi);
+    auto t4 = chrono::steady_clock::now();
+
+    auto perQueryUs = [&](auto a, auto b) { return chrono::duration<double>(b - a).count() * 1e6 / double(queries); };
+    cout << "\n" << n << " employees, " << updates << " salary updates in "
+         << chrono::duration<double>(t1 - t0).count() * 1e3 << " ms" << endl;
+    cout << "  band count via index: " << perQueryUs(t2, t3) << " us/query" << endl;
+    cout << "  band count via scan:  " << perQueryUs(t3, t4) << " us/query" << endl;
+    cout << "  results " << (indexed == scanned ? "match" : "DIFFER") << endl;
+
+    return indexed == scanned ? 0 : 1;
+}
@@ -0,0 +1,172 @@
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <limits.h>
+#include <stdexcept>
+#include <string>
+#include <sys/uio.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+using namespace std;
+
+// Employee from 2_accessModifiers_Getters_Setters.cpp (construction without
+// the per-call message), keeping displayEmployeeInfo() as the baseline.
+class Employee {
+private:
+    string name;
+    int employeeID;
+    double salary;
+
+public:
+    Employee(string empName, int empID, double empSalary)
+        : name(move(empName)), employeeID(empID), salary(empSalary >= 0 ? empSalary : 0) {}
+
+    const string& getName() const { return name; }
+    int getEmployeeID() const { return employeeID; }
+    double getSalary() const { return salary; }
+
+    void displayEmployeeInfo() const {
+        cout << "\n--- Employee Details ---" << endl;
+        cout << "Name: " << name << endl;
+        cout << "ID: " << employeeID << endl;
+        cout << "Salary: $" << salary << endl;
+    }
+};
+
+// Builds the same block of text as displayEmployeeInfo(), but into memory,
+// with to_chars for the id and the salary printed as fixed two-decimal
+// currency ("$60000.00") rather than with iostream's default precision.
+class ReportFormatter {
+public:
+    static void append(string& out, const Employee& e) {
+        char digits[32];
+        out += "\n--- Employee Details ---\nName: ";
+        out += e.getName();
+        out += "\nID: ";
+        out.append(digits, size_t(to_chars(digits, digits + sizeof(digits), e.getEmployeeID()).ptr - digits));
+        out += "\nSalary: $";
+        int64_t cents = llround(e.getSalary() * 100.0);
+        char* p = to_chars(digits, digits + sizeof(digits), cents / 100).ptr;
+        *p++ = '.';
+        *p++ = char('0' + cents % 100 / 10);
+        *p++ = char('0' + cents % 10);
+        *p++ = '\n';
+        out.append(digits, size_t(p - digits));
+    }
+};
+
+// Formats employees on several threads, each into its own buffer covering a
+// contiguous slice of the roster, then hands all buffers to the kernel in
+// order with a single writev(2). Output is byte-for-byte the same regardless
+// of thread count.
+class ReportWriter {
+private:
+    unsigned threads;
+
+    static void writeAll(int fd, vector<string>& parts) {
+        vector<iovec> iov;
+        for (string& s : parts) {
+            if (!s.empty()) {
+                iov.push_back(iovec{s.data(), s.size()});
+            }
+        }
+        size_t first = 0;
+        while (first < iov.size()) {
+            int count = int(min<size_t>(iov.size() - first, IOV_MAX));
+            ssize_t n = ::writev(fd, iov.data() + first, count);
+            if (n < 0) {
+                throw runtime_error("ReportWriter: write failed");
+            }
+            // Skip fully written buffers; trim a partially written one.
+            size_t left = size_t(n);
+            while (first < iov.size() && left >= iov[first].iov_len) {
+                left -= iov[first].iov_len;
+                ++first;
+            }
+            if (first < iov.size()) {
+                iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + left;
+                iov[first].iov_len -= left;
+            }
+        }
+    }
+
+public:
+    explicit ReportWriter(unsigned threadCount) : threads(max(1u, threadCount)) {}
+
+    void write(const vector<Employee>& roster, int fd) const {
+        vector<string> parts(threads);
+        vector<thread> pool;
+        size_t n = roster.size();
+        for (unsigned t = 0; t < threads; ++t) {
+            pool.emplace_back([&, t] {
+                size_t begin = n * t / threads, end = n * (t + 1) / threads;
+                parts[t].reserve((end - begin) * 80);
+                for (size_t i = begin; i < end; ++i) {
+                    ReportFormatter::append(parts[t], roster[i]);
+                }
+            });
+        }
+        for (auto& th : pool) {
+            th.join();
+        }
+        writeAll(fd, parts);
+    }
+
+    void write(const vector<Employee>& roster, const string& path) const {
+        int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            throw runtime_error("ReportWriter: cannot open " + path);
+        }
+        write(roster, fd);
+        ::close(fd);
+    }
+};
+
+int main(int argc, char* argv[]) {
+    vector<Employee> team = {Employee("Alice Smith", 1001, 60000.0), Employee("Bob Jones", 1002, 52000.5)};
+    cout << "displayEmployeeInfo():";
+    team[0].displayEmployeeInfo();
+    cout << "\nReportWriter:";
+    cout.flush();
+    ReportWriter(2).write(team, STDOUT_FILENO);
+
+    // Usage: ./a.out [employees] [threads] [outputPath]
+    size_t n = argc > 1 ? stoull(argv[1]) : 1'000'000;
+    unsigned threads = argc > 2 ? unsigned(stoul(argv[2])) : max(1u, thread::hardware_concurrency());
+    string path = argc > 3 ? argv[3] : "/tmp/roster_report.txt";
+
+    vector<Employee> roster;
+    roster.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        roster.emplace_back("Employee " + to_string(i), int(100'000 + i), 30'000.0 + double(i % 90'000) + 0.25);
+    }
+
+    // Baseline: displayEmployeeInfo() with cout pointed at the same file.
+    ofstream baselineFile(path + ".baseline");
+    streambuf* original = cout.rdbuf(baselineFile.rdbuf());
+    auto t0 = chrono::steady_clock::now();
+    for (const Employee& e : roster) {
+        e.displayEmployeeInfo();
+    }
+    auto t1 = chrono::steady_clock::now();
+    cout.rdbuf(original);
+
+    auto t2 = chrono::steady_clock::now();
+    ReportWriter(threads).write(roster, path);
+    auto t3 = chrono::steady_clock::now();
+
+    double before = chrono::duration<double>(t1 - t0).count(), after = chrono::duration<double>(t3 - t2).count();
+    cout << "\n" << n << " employees" << endl;
+    cout << "  displayEmployeeInfo loop: " << double(n) / before / 1e6 << " M rows/s" << endl;
+    cout << "  ReportWriter (" << threads << " threads):  " << double(n) / after / 1e6 << " M rows/s" << endl;
+
+    ::unlink(path.c_str());
+    ::unlink((path + ".baseline").c_str());
+    return 0;
+}
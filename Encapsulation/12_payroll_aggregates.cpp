@@ -0,0 +1,249 @@
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+using namespace std;
+
+class Employee;
+
+// Anyone who needs to know when a salary changes. Employee only knows this
+// interface, not what the listener does with the news.
+class SalaryObserver {
+public:
+    virtual void onHired(const Employee& e) = 0;
+    virtual void onLeft(const Employee& e) = 0;
+    virtual void onSalaryChanged(const Employee& e, double oldSalary, double newSalary) = 0;
+    virtual ~SalaryObserver() {}
+};
+
+// Employee from 2_accessModifiers_Getters_Setters.cpp plus a department, with
+// setSalary() reporting successful changes to an optional observer instead of
+// printing them. Department ids must be non-negative, since observers use
+// them as indexes. An employee reports to at most one observer, which must
+// outlive the attachment. Employees cannot be copied, because a copy would
+// report changes for a record the observer never counted.
+class Employee {
+private:
+    string name;
+    int employeeID;
+    int department;
+    double salary = 0;
+    SalaryObserver* observer = nullptr;
+
+public:
+    Employee(string empName, int empID, int dept, double empSalary)
+        : name(move(empName)), employeeID(empID), department(dept) {
+        if (dept < 0) {
+            throw invalid_argument("Employee: department must be non-negative");
+        }
+        setSalary(empSalary);
+    }
+
+    Employee(const Employee&) = delete;
+    Employee& operator=(const Employee&) = delete;
+
+    ~Employee() { detach(); }
+
+    const string& getName() const { return name; }
+    int getEmployeeID() const { return employeeID; }
+    int getDepartment() const { return department; }
+    double getSalary() const { return salary; }
+
+    // Refuses to attach when already attached; detach() first to move an
+    // employee to another observer.
+    bool attach(SalaryObserver* o) {
+        if (observer || !o) {
+            return false;
+        }
+        observer = o;
+        observer->onHired(*this);
+        return true;
+    }
+
+    void detach() {
+        if (observer) {
+            observer->onLeft(*this);
+            observer = nullptr;
+        }
+    }
+
+    bool setSalary(double newSalary) {
+        if (!(newSalary >= 0)) {
+            return false; // invalid: nothing changes, nobody is notified
+        }
+        double old = salary;
+        salary = newSalary;
+        if (observer) {
+            observer->onSalaryChanged(*this, old, newSalary);
+        }
+        return true;
+    }
+};
+
+// Running totals kept up to date on every change, so dashboards read them in
+// O(1) instead of scanning every employee. Sums are kept in integer cents so
+// that millions of +new/-old updates never drift the way a double would.
+class PayrollAggregates : public SalaryObserver {
+private:
+    struct Totals {
+        int64_t cents = 0;
+        size_t count = 0;
+    };
+    Totals company;
+    vector<Totals> byDepartment;
+
+    static int64_t toCents(double salary) { return llround(salary * 100.0); }
+
+    Totals& department(int d) {
+        if (size_t(d) >= byDepartment.size()) {
+            byDepartment.resize(size_t(d) + 1);
+        }
+        return byDepartment[size_t(d)];
+    }
+
+public:
+    void onHired(const Employee& e) override {
+        int64_t c = toCents(e.getSalary());
+        company.cents += c;
+        ++company.count;
+        Totals& d = department(e.getDepartment());
+        d.cents += c;
+        ++d.count;
+    }
+
+    void onLeft(const Employee& e) override {
+        int64_t c = toCents(e.getSalary());
+        company.cents -= c;
+        --company.count;
+        Totals& d = department(e.getDepartment());
+        d.cents -= c;
+        --d.count;
+    }
+
+    void onSalaryChanged(const Employee& e, double oldSalary, double newSalary) override {
+        int64_t delta = toCents(newSalary) - toCents(oldSalary);
+        company.cents += delta;
+        department(e.getDepartment()).cents += delta;
+    }
+
+    double totalSalary() const { return double(company.cents) / 100.0; }
+    size_t headcount() const { return company.count; }
+    double averageSalary() const { return company.count ? totalSalary() / double(company.count) : 0; }
+
+    double departmentTotal(int d) const {
+        return size_t(d) < byDepartment.size() ? double(byDepartment[size_t(d)].cents) / 100.0 : 0;
+    }
+    double departmentAverage(int d) const {
+        if (size_t(d) >= byDepartment.size() || byDepartment[size_t(d)].count == 0) {
+            return 0;
+        }
+        return departmentTotal(d) / double(byDepartment[size_t(d)].count);
+    }
+
+    // Recomputes everything from scratch and compares. Returns the number of
+    // mismatching totals (0 when consistent) and prints each mismatch.
+    size_t checkConsistency(const vector<unique_ptr<Employee>>& staff) const {
+        Totals fresh;
+        vector<Totals> freshDepartments(byDepartment.size());
+        for (const auto& e : staff) {
+            int64_t c = toCents(e->getSalary());
+            fresh.cents += c;
+            ++fresh.count;
+            if (size_t(e->getDepartment()) >= freshDepartments.size()) {
+                freshDepartments.resize(size_t(e->getDepartment()) + 1);
+            }
+            freshDepartments[size_t(e->getDepartment())].cents += c;
+            ++freshDepartments[size_t(e->getDepartment())].count;
+        }
+        size_t mismatches = 0;
+        if (fresh.cents != company.cents || fresh.count != company.count) {
+            cout << "  company totals differ: " << company.cents << " vs " << fresh.cents << endl;
+            ++mismatches;
+        }
+        for (size_t d = 0; d < freshDepartments.size(); ++d) {
+            Totals mine = d < byDepartment.size() ? byDepartment[d] : Totals{};
+            if (mine.cents != freshDepartments[d].cents || mine.count != freshDepartments[d].count) {
+                cout << "  department " << d << " differs" << endl;
+                ++mismatches;
+            }
+        }
+        return mismatches;
+    }
+};
+
+// What the dashboards did before: a full scan per read.
+double scanAverage(const vector<unique_ptr<Employee>>& staff) {
+    double sum = 0;
+    for (const auto& e : staff) {
+        sum += e->getSalary();
+    }
+    return staff.empty() ? 0 : sum / double(staff.size());
+}
+
+int main(int argc, char* argv[]) {
+    PayrollAggregates payroll;
+    vector<unique_ptr<Employee>> team;
+    team.push_back(make_unique<Employee>("Alice Smith", 1001, 0, 60000.0));
+    team.push_back(make_unique<Employee>("Bob Jones", 1002, 1, 52000.0));
+    team.push_back(make_unique<Employee>("Carol White", 1003, 1, 71000.0));
+    for (auto& e : team) {
+        e->attach(&payroll);
+    }
+    team[0]->attach(&payroll); // refused: Alice is already counted
+    try {
+        Employee("Dave Black", 1004, -1, 40000.0);
+    } catch (const invalid_argument& e) {
+        cout << "Rejected hire: " << e.what() << endl;
+    }
+    team[1]->setSalary(-5.0);  // rejected, aggregates untouched
+    team[1]->setSalary(55000.0);
+    cout << "Total $" << payroll.totalSalary() << ", average $" << payroll.averageSalary() << ", department 1 average $"
+         << payroll.departmentAverage(1) << endl;
+    team.pop_back(); // Carol leaves
+    cout << "After Carol leaves: " << payroll.headcount() << " people, total $" << payroll.totalSalary() << endl;
+
+    // Usage: ./a.out [employees] [operations] [readsPerUpdate]
+    size_t n = argc > 1 ? stoull(argv[1]) : 1'000'000;
+    size_t operations = argc > 2 ? stoull(argv[2]) : 2'000;
+    size_t readsPerUpdate = argc > 3 ? stoull(argv[3]) : 10;
+
+    mt19937_64 rng(8);
+    PayrollAggregates company;
+    vector<unique_ptr<Employee>> staff;
+    staff.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        staff.push_back(make_unique<Employee>("Employee " + to_string(i), int(i), int(i % 40),
+                                              double(30'000 + rng() % 100'000) + double(rng() % 100) / 100.0));
+        staff.back()->attach(&company);
+    }
+
+    // Mixed traffic: one salary update, then 'readsPerUpdate' dashboard reads.
+    double sink = 0;
+    auto t0 = chrono::steady_clock::now();
+    for (size_t op = 0; op < operations; ++op) {
+        staff[rng() % n]->setSalary(double(30'000 + rng() % 100'000));
+        for (size_t r = 0; r < readsPerUpdate; ++r) sink += company.averageSalary();
+    }
+    auto t1 = chrono::steady_clock::now();
+    for (size_t op = 0; op < operations; ++op) {
+        staff[rng() % n]->setSalary(double(30'000 + rng() % 100'000));
+        for (size_t r = 0; r < readsPerUpdate; ++r) sink += scanAverage(staff);
+    }
+    auto t2 = chrono::steady_clock::now();
+
+    double incremental = chrono::duration<double>(t1 - t0).count(), rescan = chrono::duration<double>(t2 - t1).count();
+    double totalOps = double(operations * (1 + readsPerUpdate));
+    cout << "\n" << n << " employees, " << operations << " updates with " << readsPerUpdate << " reads each" << endl;
+    cout << "  incremental aggregates: " << totalOps / incremental / 1e6 << " M ops/s" << endl;
+    cout << "  scan on every read:     " << totalOps / rescan / 1e6 << " M ops/s" << endl;
+    size_t mismatches = company.checkConsistency(staff);
+    cout << "  consistency check: " << (mismatches == 0 ? "ok" : "FAILED") << endl;
+    cout << "checksum " << sink << endl;
+
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,318 @@
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+// Employee from 2_accessModifiers_Getters_Setters.cpp plus the id of their
+// manager (NoManager at the top of the org).
+class Employee {
+private:
+    string name;
+    int employeeID;
+    int managerID;
+    double salary;
+
+    friend class OrgChart;
+
+public:
+    static constexpr int NoManager = -1;
+
+    Employee(string empName, int empID, int mgrID, double empSalary)
+        : name(move(empName)), employeeID(empID), managerID(mgrID), salary(empSalary >= 0 ? empSalary : 0) {}
+
+    const string& getName() const { return name; }
+    int getEmployeeID() const { return employeeID; }
+    int getManagerID() const { return managerID; }
+    double getSalary() const { return salary; }
+};
+
+// The org as pre-order arrays: every person's reports (direct and indirect)
+// occupy the contiguous range [first[row], first[row] + size[row]) of the
+// visit order. A Fenwick tree of salaries laid out in that order turns
+// "total salary under X" into two prefix sums, O(log n), and a salary change
+// into one O(log n) update. Salaries are summed in integer cents.
+//
+// A re-org changes the visit order, so it only marks the layout stale; the
+// next query rebuilds it in O(n). hire() and reassign() check for cycles
+// without the layout, so a batch of moves followed by a query costs a single
+// rebuild.
+class OrgChart {
+private:
+    vector<Employee> staff;
+    unordered_map<int, size_t> rowOf;
+    vector<size_t> first, size;    // per row, in pre-order positions
+    vector<int64_t> fenwick;       // 1-based, indexed by pre-order position
+    bool stale = true;
+
+    static int64_t toCents(double salary) { return llround(salary * 100.0); }
+
+    void add(size_t position, int64_t delta) {
+        for (size_t i = position + 1; i < fenwick.size(); i += i & (~i + 1)) {
+            fenwick[i] += delta;
+        }
+    }
+
+    // Sum of salaries at pre-order positions [0, end).
+    int64_t prefix(size_t end) const {
+        int64_t sum = 0;
+        for (size_t i = end; i > 0; i -= i & (~i + 1)) {
+            sum += fenwick[i];
+        }
+        return sum;
+    }
+
+    void rebuild() {
+        size_t n = staff.size();
+        // Children in CSR form: reports of row r are kids[start[r] .. start[r + 1]).
+        vector<size_t> start(n + 1, 0), kids(n), roots;
+        vector<size_t> managerRow(n, SIZE_MAX);
+        for (size_t r = 0; r < n; ++r) {
+            auto it = rowOf.find(staff[r].managerID);
+            if (it == rowOf.end()) {
+                roots.push_back(r);
+            } else {
+                managerRow[r] = it->second;
+                ++start[it->second + 1];
+            }
+        }
+        for (size_t r = 0; r < n; ++r) start[r + 1] += start[r];
+        vector<size_t> fill(start.begin(), start.end() - 1);
+        for (size_t r = 0; r < n; ++r) {
+            if (managerRow[r] != SIZE_MAX) kids[fill[managerRow[r]]++] = r;
+        }
+
+        // Iterative pre-order walk (org depth can exceed a safe recursion depth).
+        first.assign(n, 0);
+        size.assign(n, 1);
+        vector<size_t> order, stack;
+        order.reserve(n);
+        for (size_t root : roots) {
+            stack.push_back(root);
+            while (!stack.empty()) {
+                size_t r = stack.back();
+                stack.pop_back();
+                first[r] = order.size();
+                order.push_back(r);
+                for (size_t k = start[r + 1]; k > start[r]; --k) stack.push_back(kids[k - 1]);
+            }
+        }
+        if (order.size() != n) {
+            throw logic_error("OrgChart: management chain contains a cycle");
+        }
+        // Children come after their manager in pre-order, so walking it
+        // backwards completes every subtree size before it is needed.
+        for (size_t p = n; p-- > 0;) {
+            if (managerRow[order[p]] != SIZE_MAX) size[managerRow[order[p]]] += size[order[p]];
+        }
+
+        // O(n) Fenwick construction: each node pushes its total to its parent.
+        fenwick.assign(n + 1, 0);
+        for (size_t p = 0; p < n; ++p) fenwick[p + 1] = toCents(staff[order[p]].salary);
+        for (size_t i = 1; i <= n; ++i) {
+            size_t parent = i + (i & (~i + 1));
+            if (parent <= n) fenwick[parent] += fenwick[i];
+        }
+        stale = false;
+    }
+
+    void refresh() {
+        if (stale) rebuild();
+    }
+
+    size_t row(int employeeID) const {
+        auto it = rowOf.find(employeeID);
+        if (it == rowOf.end()) {
+            throw invalid_argument("OrgChart: unknown employee " + to_string(employeeID));
+        }
+        return it->second;
+    }
+
+    // True when walking up the management chain from 'fromID' meets
+    // 'targetID'. Managers that have not been hired end the chain. The walk
+    // is capped at one step per employee, so even a corrupt chain terminates
+    // (and counts as a hit).
+    bool chainReaches(int fromID, int targetID) const {
+        int id = fromID;
+        for (size_t steps = 0; steps <= staff.size(); ++steps) {
+            if (id == targetID) {
+                return true;
+            }
+            auto it = rowOf.find(id);
+            if (it == rowOf.end()) {
+                return false;
+            }
+            id = staff[it->second].managerID;
+        }
+        return true;
+    }
+
+public:
+    // Refuses a hire whose manager chain leads back to the new employee
+    // (e.g. A under B after B was hired under A), which would be a cycle.
+    bool hire(Employee e) {
+        if (chainReaches(e.managerID, e.employeeID)) {
+            return false;
+        }
+        rowOf[e.employeeID] = staff.size();
+        staff.push_back(move(e));
+        stale = true;
+        return true;
+    }
+
+    size_t headcount() const { return staff.size(); }
+
+    // Same rule as Employee::setSalary: negative salaries are rejected.
+    bool setSalary(int employeeID, double newSalary) {
+        auto it = rowOf.find(employeeID);
+        if (it == rowOf.end() || !(newSalary >= 0)) {
+            return false;
+        }
+        Employee& e = staff[it->second];
+        if (!stale) add(first[it->second], toCents(newSalary) - toCents(e.salary));
+        e.salary = newSalary;
+        return true;
+    }
+
+    // Moves 'employeeID' (and everyone under them) to report to 'newManagerID'.
+    // Refuses moves that would put someone under their own reports. The check
+    // walks up the new manager's chain, O(depth), instead of consulting the
+    // pre-order layout, so a run of moves does not rebuild it once per move.
+    bool reassign(int employeeID, int newManagerID) {
+        size_t moving = row(employeeID);
+        if (newManagerID != Employee::NoManager) {
+            row(newManagerID); // must be someone we know
+        }
+        if (chainReaches(newManagerID, employeeID)) {
+            return false;
+        }
+        staff[moving].managerID = newManagerID;
+        stale = true;
+        return true;
+    }
+
+    // True when 'employeeID' is 'managerID' or reports to them, at any depth.
+    bool isUnder(int employeeID, int managerID) {
+        refresh();
+        size_t e = row(employeeID), m = row(managerID);
+        return first[e] >= first[m] && first[e] < first[m] + size[m];
+    }
+
+    // Total salary of the manager and everyone under them.
+    double subtreeSalary(int managerID) {
+        refresh();
+        size_t m = row(managerID);
+        return double(prefix(first[m] + size[m]) - prefix(first[m])) / 100.0;
+    }
+
+    size_t subtreeHeadcount(int managerID) {
+        refresh();
+        return size[row(managerID)];
+    }
+
+    const vector<Employee>& employees() const { return staff; }
+};
+
+// Reference answer without the pre-order layout: decide for every employee
+// whether their manager chain reaches 'managerID', remembering answers along
+// the way so each chain is walked once.
+double naiveSubtreeSalary(const vector<Employee>& staff, const unordered_map<int, size_t>& rowOf, int managerID) {
+    enum : char { Unknown, Yes, No };
+    vector<char> under(staff.size(), Unknown);
+    vector<size_t> path;
+    int64_t cents = 0;
+    for (size_t r = 0; r < staff.size(); ++r) {
+        size_t cur = r;
+        char answer = Unknown;
+        while (answer == Unknown) {
+            if (under[cur] != Unknown) {
+                answer = under[cur];
+                break;
+            }
+            path.push_back(cur);
+            if (staff[cur].getEmployeeID() == managerID) {
+                answer = Yes;
+            } else if (staff[cur].getManagerID() == Employee::NoManager) {
+                answer = No;
+            } else {
+                cur = rowOf.at(staff[cur].getManagerID());
+            }
+        }
+        for (size_t p : path) under[p] = answer;
+        path.clear();
+        if (answer == Yes) cents += llround(staff[r].getSalary() * 100.0);
+    }
+    return double(cents) / 100.0;
+}
+
+int main(int argc, char* argv[]) {
+    OrgChart team;
+    team.hire(Employee("Alice Smith", 1, Employee::NoManager, 150000.0));
+    team.hire(Employee("Bob Jones", 2, 1, 90000.0));
+    team.hire(Employee("Carol White", 3, 1, 95000.0));
+    team.hire(Employee("Dan Brown", 4, 2, 60000.0));
+    cout << "Under Alice: $" << team.subtreeSalary(1) << ", under Bob: $" << team.subtreeSalary(2) << endl;
+    team.reassign(4, 3);
+    team.setSalary(4, 65000.0);
+    cout << "Dan moves to Carol: under Bob $" << team.subtreeSalary(2) << ", under Carol $" << team.subtreeSalary(3)
+         << endl;
+    cout << "Alice under Dan allowed? " << (team.reassign(1, 4) ? "yes" : "no") << endl;
+    // Erin is hired under Frank before Frank joins; Frank may not then be
+    // hired under Erin.
+    team.hire(Employee("Erin Green", 5, 6, 70000.0));
+    cout << "Frank hired under Erin? " << (team.hire(Employee("Frank Black", 6, 5, 72000.0)) ? "yes" : "no") << endl;
+
+    // Usage: ./a.out [employees] [queries] [updates] [reorgs]
+    size_t n = argc > 1 ? stoull(argv[1]) : 500'000;
+    size_t queries = argc > 2 ? stoull(argv[2]) : 1'000'000;
+    size_t updates = argc > 3 ? stoull(argv[3]) : 1'000'000;
+    size_t reorgs = argc > 4 ? stoull(argv[4]) : 100;
+
+    // Each person reports to someone hired shortly before them, which gives a
+    // deep, bushy org like a real one.
+    mt19937_64 rng(23);
+    OrgChart org;
+    for (size_t i = 0; i < n; ++i) {
+        int manager = i == 0 ? Employee::NoManager : int(i - 1 - rng() % min<size_t>(i, 50));
+        org.hire(Employee("Employee " + to_string(i), int(i), manager, double(40'000 + rng() % 160'000)));
+    }
+    org.subtreeHeadcount(0); // builds the layout
+
+    double sink = 0;
+    auto t0 = chrono::steady_clock::now();
+    for (size_t q = 0; q < queries; ++q) sink += org.subtreeSalary(int(rng() % n));
+    auto t1 = chrono::steady_clock::now();
+    for (size_t u = 0; u < updates; ++u) org.setSalary(int(rng() % n), double(40'000 + rng() % 160'000));
+    auto t2 = chrono::steady_clock::now();
+    size_t moved = 0;
+    for (size_t r = 0; r < reorgs; ++r) {
+        int who = int(1 + rng() % (n - 1));
+        moved += org.reassign(who, int(rng() % n));
+    }
+    org.subtreeHeadcount(0); // one rebuild for the whole batch of moves
+    auto t3 = chrono::steady_clock::now();
+
+    auto us = [](auto a, auto b, size_t count) { return chrono::duration<double>(b - a).count() * 1e6 / double(count); };
+    cout << "\n" << n << "-person org" << endl;
+    cout << "  subtree salary query: " << us(t0, t1, queries) << " us" << endl;
+    cout << "  salary update:        " << us(t1, t2, updates) << " us" << endl;
+    cout << "  " << reorgs << " re-orgs + one rebuild: " << chrono::duration<double>(t3 - t2).count() * 1e3 << " ms ("
+         << moved << " moves accepted)" << endl;
+
+    // Spot-check against the naive walk after all the updates and moves.
+    unordered_map<int, size_t> rowOf;
+    for (size_t r = 0; r < n; ++r) rowOf[org.employees()[r].getEmployeeID()] = r;
+    size_t mismatches = 0;
+    for (int probe : {0, 1, int(n / 3), int(n / 2), int(n - 1)}) {
+        if (fabs(org.subtreeSalary(probe) - naiveSubtreeSalary(org.employees(), rowOf, probe)) > 0.005) ++mismatches;
+    }
+    cout << "  check against naive walk: " << (mismatches == 0 ? "ok" : "FAILED") << endl;
+    cout << "checksum " << sink << endl;
+
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,342 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+// Employee as in 2_accessModifiers_Getters_Setters.cpp. Directory versions
+// treat it as immutable: an update replaces the whole record.
+class Employee {
+private:
+    string name;
+    int employeeID;
+    double salary;
+
+public:
+    Employee(string empName, int empID, double empSalary)
+        : name(move(empName)), employeeID(empID), salary(empSalary >= 0 ? empSalary : 0) {}
+
+    const string& getName() const { return name; }
+    int getEmployeeID() const { return employeeID; }
+    double getSalary() const { return salary; }
+};
+
+// Epoch-based reclamation. Each reader owns a slot where it announces the
+// global epoch it entered at, or Idle. A writer that unpublishes an object
+// retires it tagged with the current epoch and then advances the epoch; the
+// object is freed once every slot is Idle or announces a later epoch, because
+// any reader entering after the advance can only reach the new version.
+class EpochDomain {
+public:
+    static constexpr size_t MaxReaders = 64;
+
+private:
+    static constexpr uint64_t Idle = UINT64_MAX;
+
+    struct alignas(64) Slot {
+        atomic<uint64_t> epoch{Idle};
+        atomic<bool> claimed{false};
+    };
+    struct Retired {
+        uint64_t epoch;
+        const void* object;
+        void (*destroy)(const void*);
+    };
+
+    Slot slots[MaxReaders];
+    alignas(64) atomic<uint64_t> globalEpoch{1};
+    vector<Retired> retired; // touched only by the (single, locked) writer
+
+public:
+    EpochDomain() = default;
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    ~EpochDomain() {
+        for (const Retired& r : retired) r.destroy(r.object);
+    }
+
+    // Claims a free slot; slots come back through releaseReader(), so the
+    // limit is on readers alive at once, not on readers ever created.
+    size_t registerReader() {
+        for (size_t s = 0; s < MaxReaders; ++s) {
+            bool expected = false;
+            if (slots[s].claimed.compare_exchange_strong(expected, true)) {
+                return s;
+            }
+        }
+        throw runtime_error("EpochDomain: too many readers");
+    }
+
+    void releaseReader(size_t slot) {
+        slots[slot].epoch.store(Idle, memory_order_release);
+        slots[slot].claimed.store(false, memory_order_release);
+    }
+
+    // The announcement must be visible before the reader loads any shared
+    // pointer, hence sequentially consistent stores and loads on both sides.
+    void enter(size_t slot) { slots[slot].epoch.store(globalEpoch.load()); }
+    void exit(size_t slot) { slots[slot].epoch.store(Idle, memory_order_release); }
+
+    // enter() for the lifetime of the guard, so a read that throws still
+    // leaves its slot Idle instead of pinning every later retirement.
+    class Guard {
+    private:
+        EpochDomain& domain;
+        size_t slot;
+
+    public:
+        Guard(EpochDomain& d, size_t s) : domain(d), slot(s) { domain.enter(slot); }
+        ~Guard() { domain.exit(slot); }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+    };
+
+    // Writer side; the caller serialises writers.
+    template <typename T>
+    void retire(const T* object) {
+        retired.push_back({globalEpoch.load(), object, [](const void* p) { delete static_cast<const T*>(p); }});
+    }
+
+    // Advances the epoch and frees everything no reader can still see.
+    void advanceAndReclaim() {
+        globalEpoch.fetch_add(1);
+        uint64_t oldestActive = Idle;
+        for (size_t s = 0; s < MaxReaders; ++s) {
+            oldestActive = min(oldestActive, slots[s].epoch.load());
+        }
+        size_t kept = 0;
+        for (const Retired& r : retired) {
+            if (r.epoch < oldestActive) {
+                r.destroy(r.object);
+            } else {
+                retired[kept++] = r;
+            }
+        }
+        retired.resize(kept);
+    }
+
+    size_t pendingReclamation() const { return retired.size(); }
+};
+
+// Employee directory with read-copy-update. Each row is an atomic pointer to
+// an immutable Employee. Readers follow that pointer and never lock or wait.
+// A writer builds the replacement record off to the side, publishes it with
+// a single atomic exchange, and retires the old record through the
+// EpochDomain. A reader therefore sees the old record or the new one, never a
+// mix, and no reader can be left holding a freed record. The set of ids is
+// fixed when the directory is built, so the id-to-row map is read without
+// any locking.
+class EmployeeDirectory {
+private:
+    EpochDomain epochs;
+    unique_ptr<atomic<const Employee*>[]> rows;
+    size_t rowCount;
+    unordered_map<int, size_t> rowOf;
+    mutex writerLock; // serialises writers only; readers never touch it
+
+public:
+    explicit EmployeeDirectory(const vector<Employee>& staff)
+        : rows(make_unique<atomic<const Employee*>[]>(staff.size())), rowCount(staff.size()) {
+        for (size_t r = 0; r < staff.size(); ++r) {
+            rows[r].store(new Employee(staff[r]), memory_order_relaxed);
+            rowOf[staff[r].getEmployeeID()] = r;
+        }
+    }
+
+    EmployeeDirectory(const EmployeeDirectory&) = delete;
+    EmployeeDirectory& operator=(const EmployeeDirectory&) = delete;
+
+    ~EmployeeDirectory() {
+        for (size_t r = 0; r < rowCount; ++r) delete rows[r].load();
+    }
+
+    // One per reading thread. 'read' runs 'f' on a consistent record; the
+    // reference must not escape 'f'.
+    class Reader {
+    private:
+        EmployeeDirectory& directory;
+        size_t slot;
+
+    public:
+        explicit Reader(EmployeeDirectory& d) : directory(d), slot(d.epochs.registerReader()) {}
+        ~Reader() { directory.epochs.releaseReader(slot); }
+
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+
+        template <typename F>
+        bool read(int employeeID, F f) {
+            auto it = directory.rowOf.find(employeeID);
+            if (it == directory.rowOf.end()) {
+                return false;
+            }
+            EpochDomain::Guard inside(directory.epochs, slot);
+            f(*directory.rows[it->second].load());
+            return true;
+        }
+    };
+
+    // Replaces the record with the same id.
+    bool update(const Employee& e) {
+        auto it = rowOf.find(e.getEmployeeID());
+        if (it == rowOf.end()) {
+            return false;
+        }
+        const Employee* next = new Employee(e);
+        lock_guard<mutex> guard(writerLock);
+        epochs.retire(rows[it->second].exchange(next));
+        epochs.advanceAndReclaim();
+        return true;
+    }
+
+    size_t pendingReclamation() {
+        lock_guard<mutex> guard(writerLock);
+        return epochs.pendingReclamation();
+    }
+};
+
+// Baseline: the same records behind a reader-writer lock.
+class LockedDirectory {
+private:
+    vector<Employee> staff;
+    unordered_map<int, size_t> rowOf;
+    mutable shared_mutex lock;
+
+public:
+    explicit LockedDirectory(const vector<Employee>& s) : staff(s) {
+        for (size_t r = 0; r < staff.size(); ++r) rowOf[staff[r].getEmployeeID()] = r;
+    }
+
+    class Reader {
+    private:
+        LockedDirectory& directory;
+
+    public:
+        explicit Reader(LockedDirectory& d) : directory(d) {}
+
+        template <typename F>
+        bool read(int employeeID, F f) {
+            auto it = directory.rowOf.find(employeeID);
+            if (it == directory.rowOf.end()) {
+                return false;
+            }
+            shared_lock<shared_mutex> guard(directory.lock);
+            f(directory.staff[it->second]);
+            return true;
+        }
+    };
+
+    bool update(const Employee& e) {
+        auto it = rowOf.find(e.getEmployeeID());
+        if (it == rowOf.end()) {
+            return false;
+        }
+        unique_lock<shared_mutex> guard(lock);
+        staff[it->second] = e;
+        return true;
+    }
+};
+
+// Name and salary are always written together, and the name ends with the
+// salary's last digit, so a reader can spot a torn record cheaply.
+Employee makeRecord(int id, int salary) {
+    return Employee("Employee " + to_string(id) + " grade " + to_string(salary), id, double(salary));
+}
+
+bool consistent(const Employee& e) {
+    return e.getName().back() == char('0' + int64_t(e.getSalary()) % 10);
+}
+
+struct RunResult {
+    double readsPerSecond;
+    size_t tornReads;
+};
+
+// Every thread does 'operations' lookups, turning 'writePercent' of them into
+// updates of a random employee.
+template <typename Directory>
+RunResult run(Directory& directory, size_t employees, unsigned threads, size_t operations, unsigned writePercent) {
+    atomic<size_t> reads{0}, torn{0};
+    vector<thread> pool;
+    auto t0 = chrono::steady_clock::now();
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            typename Directory::Reader reader(directory);
+            mt19937_64 rng(t + 1);
+            size_t myReads = 0, myTorn = 0;
+            for (size_t op = 0; op < operations; ++op) {
+                int id = int(rng() % employees);
+                if (rng() % 100 < writePercent) {
+                    directory.update(makeRecord(id, int(30'000 + rng() % 100'000)));
+                } else {
+                    reader.read(id, [&](const Employee& e) { myTorn += !consistent(e); });
+                    ++myReads;
+                }
+            }
+            reads += myReads;
+            torn += myTorn;
+        });
+    }
+    for (auto& th : pool) {
+        th.join();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    return {double(reads.load()) / seconds, torn.load()};
+}
+
+int main(int argc, char* argv[]) {
+    vector<Employee> team = {makeRecord(1001, 60000), makeRecord(1002, 52000)};
+    EmployeeDirectory directory(team);
+    EmployeeDirectory::Reader reader(directory);
+    directory.update(makeRecord(1002, 55000));
+    reader.read(1002, [](const Employee& e) { cout << e.getName() << ": $" << e.getSalary() << endl; });
+    cout << "Versions awaiting reclamation: " << directory.pendingReclamation() << endl;
+    try {
+        reader.read(1001, [](const Employee&) { throw runtime_error("callback failed"); });
+    } catch (const runtime_error&) {
+        directory.update(makeRecord(1001, 61000)); // the failed read left nothing pinned
+        cout << "After a throwing read: " << directory.pendingReclamation() << " awaiting reclamation" << endl;
+    }
+    for (size_t i = 0; i < 4 * EpochDomain::MaxReaders; ++i) {
+        EmployeeDirectory::Reader shortLived(directory); // slots are reused, never exhausted
+    }
+
+    // Usage: ./a.out [employees] [threads] [operationsPerThread]
+    size_t n = argc > 1 ? stoull(argv[1]) : 100'000;
+    unsigned threads = argc > 2 ? unsigned(stoul(argv[2])) : max(4u, thread::hardware_concurrency());
+    size_t operations = argc > 3 ? stoull(argv[3]) : 1'000'000;
+    threads = min<unsigned>(threads, EpochDomain::MaxReaders);
+
+    vector<Employee> staff;
+    staff.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        staff.push_back(makeRecord(int(i), int(30'000 + i % 100'000)));
+    }
+
+    cout << "\n" << n << " employees, " << threads << " threads, " << operations << " operations each" << endl;
+    size_t torn = 0;
+    for (unsigned writePercent : {1u, 10u}) {
+        LockedDirectory locked(staff);
+        EmployeeDirectory rcu(staff);
+        RunResult a = run(locked, n, threads, operations, writePercent);
+        RunResult b = run(rcu, n, threads, operations, writePercent);
+        torn += a.tornReads + b.tornReads;
+        cout << "  " << writePercent << "% writes: shared_mutex " << a.readsPerSecond / 1e6 << " M reads/s, RCU "
+             << b.readsPerSecond / 1e6 << " M reads/s (" << rcu.pendingReclamation() << " objects awaiting reclamation)"
+             << endl;
+    }
+    cout << "  torn reads: " << torn << endl;
+
+    return torn == 0 ? 0 : 1;
+}
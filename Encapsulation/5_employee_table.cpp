@@ -0,0 +1,280 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+using namespace std;
+
+// Same data and getters as Employee in 2_accessModifiers_Getters_Setters.cpp,
+// minus the console output, so a vector of them can be built for the
+// comparison below without printing millions of lines.
+class Employee {
+private:
+    string name;
+    int employeeID;
+    double salary;
+
+public:
+    Employee(string empName, int empID, double empSalary)
+        : name(move(empName)), employeeID(empID), salary(empSalary >= 0 ? empSalary : 0) {}
+
+    string getName() const { return name; }
+    int getEmployeeID() const { return employeeID; }
+    double getSalary() const { return salary; }
+};
+
+struct SalaryStats {
+    size_t count;
+    double sum;
+    double min;
+    double max;
+    double mean;
+    double stddev; // population standard deviation
+};
+
+namespace kernels {
+
+struct SumMinMax {
+    double sum, min, max;
+};
+
+SumMinMax sumMinMaxScalar(const double* v, size_t n) {
+    // Four independent accumulators break the add dependency chain.
+    double s[4] = {0, 0, 0, 0};
+    double lo = numeric_limits<double>::infinity(), hi = -lo;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        for (int k = 0; k < 4; ++k) {
+            s[k] += v[i + k];
+            lo = min(lo, v[i + k]);
+            hi = max(hi, v[i + k]);
+        }
+    }
+    for (; i < n; ++i) {
+        s[0] += v[i];
+        lo = min(lo, v[i]);
+        hi = max(hi, v[i]);
+    }
+    return {(s[0] + s[1]) + (s[2] + s[3]), lo, hi};
+}
+
+double sumSquaredDeviationsScalar(const double* v, size_t n, double mean) {
+    double s[4] = {0, 0, 0, 0};
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        for (int k = 0; k < 4; ++k) {
+            double d = v[i + k] - mean;
+            s[k] += d * d;
+        }
+    }
+    for (; i < n; ++i) {
+        double d = v[i] - mean;
+        s[0] += d * d;
+    }
+    return (s[0] + s[1]) + (s[2] + s[3]);
+}
+
+#if defined(__x86_64__)
+__attribute__((target("avx2,fma"))) SumMinMax sumMinMaxAvx2(const double* v, size_t n) {
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+    __m256d lo = _mm256_set1_pd(numeric_limits<double>::infinity());
+    __m256d hi = _mm256_set1_pd(-numeric_limits<double>::infinity());
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256d a = _mm256_loadu_pd(v + i), b = _mm256_loadu_pd(v + i + 4);
+        s0 = _mm256_add_pd(s0, a);
+        s1 = _mm256_add_pd(s1, b);
+        lo = _mm256_min_pd(lo, _mm256_min_pd(a, b));
+        hi = _mm256_max_pd(hi, _mm256_max_pd(a, b));
+    }
+    alignas(32) double sums[4], mins[4], maxs[4];
+    _mm256_store_pd(sums, _mm256_add_pd(s0, s1));
+    _mm256_store_pd(mins, lo);
+    _mm256_store_pd(maxs, hi);
+    SumMinMax tail = sumMinMaxScalar(v + i, n - i);
+    return {(sums[0] + sums[1]) + (sums[2] + sums[3]) + tail.sum,
+            min({mins[0], mins[1], mins[2], mins[3], tail.min}),
+            max({maxs[0], maxs[1], maxs[2], maxs[3], tail.max})};
+}
+
+__attribute__((target("avx2,fma"))) double sumSquaredDeviationsAvx2(const double* v, size_t n, double mean) {
+    __m256d m = _mm256_set1_pd(mean);
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256d a = _mm256_sub_pd(_mm256_loadu_pd(v + i), m);
+        __m256d b = _mm256_sub_pd(_mm256_loadu_pd(v + i + 4), m);
+        s0 = _mm256_fmadd_pd(a, a, s0);
+        s1 = _mm256_fmadd_pd(b, b, s1);
+    }
+    alignas(32) double sums[4];
+    _mm256_store_pd(sums, _mm256_add_pd(s0, s1));
+    return (sums[0] + sums[1]) + (sums[2] + sums[3]) + sumSquaredDeviationsScalar(v + i, n - i, mean);
+}
+#endif
+
+SumMinMax sumMinMax(const double* v, size_t n) {
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return sumMinMaxAvx2(v, n);
+    }
+#endif
+    return sumMinMaxScalar(v, n);
+}
+
+double sumSquaredDeviations(const double* v, size_t n, double mean) {
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return sumSquaredDeviationsAvx2(v, n, mean);
+    }
+#endif
+    return sumSquaredDeviationsScalar(v, n, mean);
+}
+
+} // namespace kernels
+
+// Employees stored column by column. Row i is (ids[i], salaries[i], names[i]).
+// A salary query touches only the 8-byte salary column, never the strings,
+// so it streams through memory at full bandwidth.
+class EmployeeTable {
+private:
+    vector<int> ids;
+    vector<double> salaries;
+    vector<string> names;
+
+public:
+    void reserve(size_t n) {
+        ids.reserve(n);
+        salaries.reserve(n);
+        names.reserve(n);
+    }
+
+    // Same validation as Employee::setSalary: negative salaries are refused.
+    // Returns the new row, or throws invalid_argument.
+    size_t add(string name, int employeeID, double salary) {
+        if (!(salary >= 0)) {
+            throw invalid_argument("EmployeeTable: salary must be non-negative");
+        }
+        ids.push_back(employeeID);
+        salaries.push_back(salary);
+        names.push_back(move(name));
+        return ids.size() - 1;
+    }
+
+    size_t size() const { return ids.size(); }
+    int getEmployeeID(size_t row) const { return ids[row]; }
+    double getSalary(size_t row) const { return salaries[row]; }
+    const string& getName(size_t row) const { return names[row]; }
+
+    const vector<double>& salaryColumn() const { return salaries; }
+
+    SalaryStats salaryStats() const {
+        size_t n = salaries.size();
+        if (n == 0) {
+            return {0, 0, 0, 0, 0, 0};
+        }
+        kernels::SumMinMax smm = kernels::sumMinMax(salaries.data(), n);
+        double mean = smm.sum / double(n);
+        // Two passes: sum of squared deviations from the mean is far more
+        // accurate than sum(x^2) - n*mean^2 for large salaries.
+        double variance = kernels::sumSquaredDeviations(salaries.data(), n, mean) / double(n);
+        return {n, smm.sum, smm.min, smm.max, mean, sqrt(variance)};
+    }
+
+    // Nearest-rank percentiles (p in [0, 100]). Sorting one scratch copy of
+    // the column serves every requested percentile.
+    vector<double> salaryPercentiles(const vector<double>& ps) const {
+        vector<double> sorted = salaries;
+        sort(sorted.begin(), sorted.end());
+        vector<double> result;
+        for (double p : ps) {
+            if (sorted.empty()) {
+                result.push_back(0);
+                continue;
+            }
+            size_t rank = size_t(ceil(clamp(p, 0.0, 100.0) / 100.0 * double(sorted.size())));
+            result.push_back(sorted[rank == 0 ? 0 : rank - 1]);
+        }
+        return result;
+    }
+
+    // Single percentile in O(n) via nth_element.
+    double salaryPercentile(double p) const {
+        if (salaries.empty()) {
+            return 0;
+        }
+        vector<double> scratch = salaries;
+        size_t rank = size_t(ceil(clamp(p, 0.0, 100.0) / 100.0 * double(scratch.size())));
+        size_t index = rank == 0 ? 0 : rank - 1;
+        nth_element(scratch.begin(), scratch.begin() + ptrdiff_t(index), scratch.end());
+        return scratch[index];
+    }
+};
+
+void printStats(const string& label, const SalaryStats& s, double seconds) {
+    cout << "  " << label << ": sum " << s.sum << ", min " << s.min << ", max " << s.max << ", mean " << s.mean
+         << ", stddev " << s.stddev << "  (" << seconds * 1e3 << " ms)" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    EmployeeTable team;
+    team.add("Alice Smith", 1001, 60000.0);
+    team.add("Bob Jones", 1002, 52000.0);
+    team.add("Carol White", 1003, 71000.0);
+    SalaryStats small = team.salaryStats();
+    cout << "Team of " << small.count << ": mean $" << small.mean << ", max $" << small.max << ", median $"
+         << team.salaryPercentile(50) << endl;
+
+    // Usage: ./a.out [employees]
+    size_t n = argc > 1 ? stoull(argv[1]) : 5'000'000;
+    mt19937_64 rng(11);
+    lognormal_distribution<double> pay(11.0, 0.4);
+
+    EmployeeTable table;
+    vector<Employee> objects;
+    table.reserve(n);
+    objects.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        double salary = round(pay(rng));
+        string name = "Employee number " + to_string(i); // long enough to defeat SSO
+        table.add(name, int(i), salary);
+        objects.emplace_back(move(name), int(i), salary);
+    }
+
+    cout << "\nSalary aggregates over " << n << " employees" << endl;
+    auto t0 = chrono::steady_clock::now();
+    SalaryStats columnar = table.salaryStats();
+    auto t1 = chrono::steady_clock::now();
+    printStats("EmployeeTable        ", columnar, chrono::duration<double>(t1 - t0).count());
+
+    auto t2 = chrono::steady_clock::now();
+    double sum = 0, lo = numeric_limits<double>::infinity(), hi = -lo;
+    for (const Employee& e : objects) {
+        sum += e.getSalary();
+        lo = min(lo, e.getSalary());
+        hi = max(hi, e.getSalary());
+    }
+    double mean = sum / double(n), sq = 0;
+    for (const Employee& e : objects) {
+        sq += (e.getSalary() - mean) * (e.getSalary() - mean);
+    }
+    auto t3 = chrono::steady_clock::now();
+    printStats("vector<Employee> loop", SalaryStats{n, sum, lo, hi, mean, sqrt(sq / double(n))},
+               chrono::duration<double>(t3 - t2).count());
+
+    auto t4 = chrono::steady_clock::now();
+    vector<double> pct = table.salaryPercentiles({50, 90, 99});
+    auto t5 = chrono::steady_clock::now();
+    cout << "  p50 " << pct[0] << ", p90 " << pct[1] << ", p99 " << pct[2] << "  ("
+         << chrono::duration<double>(t5 - t4).count() * 1e3 << " ms)" << endl;
+
+    return 0;
+}
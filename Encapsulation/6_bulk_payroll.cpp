@@ -0,0 +1,173 @@
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+// Employee from 2_accessModifiers_Getters_Setters.cpp with the validation
+// split from the reporting: trySetSalary() only validates and updates, and
+// setSalary() keeps the original per-call message on top of it.
+class Employee {
+private:
+    string name;
+    int employeeID;
+    double salary = 0;
+
+public:
+    Employee(string empName, int empID, double empSalary) : name(move(empName)), employeeID(empID) {
+        trySetSalary(empSalary);
+    }
+
+    string getName() const { return name; }
+    int getEmployeeID() const { return employeeID; }
+    double getSalary() const { return salary; }
+
+    // Validation only: no I/O. Returns false and leaves the salary unchanged
+    // for negative or non-finite values.
+    bool trySetSalary(double newSalary) {
+        if (newSalary >= 0 && isfinite(newSalary)) {
+            salary = newSalary;
+            return true;
+        }
+        return false;
+    }
+
+    void setSalary(double newSalary, ostream& log = cout) {
+        if (trySetSalary(newSalary)) {
+            log << "Salary updated successfully to: " << salary << endl;
+        } else {
+            log << "Error: Invalid salary amount. Salary must be non-negative." << endl;
+        }
+    }
+};
+
+// One entry of the structured error report.
+struct PayrollError {
+    enum Reason : uint8_t { UnknownEmployee, InvalidSalary, AboveCap } reason;
+    size_t position;        // index into the ids span
+    int employeeID;
+    double currentSalary;   // 0 for UnknownEmployee
+    double rejectedSalary;  // what the adjustment asked for
+};
+
+const char* describe(PayrollError::Reason r) {
+    switch (r) {
+        case PayrollError::UnknownEmployee: return "unknown employee";
+        case PayrollError::InvalidSalary: return "invalid salary";
+        case PayrollError::AboveCap: return "above salary cap";
+    }
+    return "unknown";
+}
+
+struct PayrollResult {
+    vector<uint64_t> rejected; // bit i set => ids[i] was not updated
+    vector<PayrollError> errors;
+
+    bool wasRejected(size_t i) const { return (rejected[i / 64] >> (i % 64)) & 1; }
+    size_t rejectedCount() const { return errors.size(); }
+};
+
+class Payroll {
+private:
+    vector<Employee> staff;
+    unordered_map<int, size_t> rowOf; // employee id -> index in staff
+    double salaryCap;
+
+public:
+    explicit Payroll(double cap = 1e9) : salaryCap(cap) {}
+
+    void hire(Employee e) {
+        rowOf[e.getEmployeeID()] = staff.size();
+        staff.push_back(move(e));
+    }
+
+    Employee& find(int id) { return staff[rowOf.at(id)]; }
+    const vector<Employee>& employees() const { return staff; }
+
+    // Applies newSalary = adjust(oldSalary) to every listed employee, in
+    // order, without printing anything. Updates that fail validation leave
+    // the salary untouched and are reported in the result.
+    PayrollResult applyRaise(span<const int> ids, const function<double(double)>& adjust) {
+        PayrollResult result;
+        result.rejected.assign((ids.size() + 63) / 64, 0);
+        auto reject = [&](size_t i, PayrollError::Reason why, double current, double attempted) {
+            result.rejected[i / 64] |= uint64_t(1) << (i % 64);
+            result.errors.push_back({why, i, ids[i], current, attempted});
+        };
+
+        for (size_t i = 0; i < ids.size(); ++i) {
+            auto it = rowOf.find(ids[i]);
+            if (it == rowOf.end()) {
+                reject(i, PayrollError::UnknownEmployee, 0, 0);
+                continue;
+            }
+            Employee& e = staff[it->second];
+            double proposed = adjust(e.getSalary());
+            if (proposed > salaryCap) {
+                reject(i, PayrollError::AboveCap, e.getSalary(), proposed);
+            } else if (!e.trySetSalary(proposed)) {
+                reject(i, PayrollError::InvalidSalary, e.getSalary(), proposed);
+            }
+        }
+        return result;
+    }
+
+    // Percentage raise, e.g. 3.5 for +3.5% or -10 for a 10% cut. Rounded to cents.
+    PayrollResult applyRaise(span<const int> ids, double percent) {
+        double factor = 1.0 + percent / 100.0;
+        return applyRaise(ids, [factor](double s) { return round(s * factor * 100.0) / 100.0; });
+    }
+};
+
+int main(int argc, char* argv[]) {
+    Payroll small(200'000.0);
+    small.hire(Employee("Alice Smith", 1001, 60000.0));
+    small.hire(Employee("Bob Jones", 1002, 195000.0));
+    small.hire(Employee("Carol White", 1003, 71000.0));
+
+    vector<int> ids = {1001, 1002, 4242, 1003};
+    PayrollResult r = small.applyRaise(ids, 5.0);
+    for (const PayrollError& e : r.errors) {
+        cout << "rejected #" << e.position << " (id " << e.employeeID << "): " << describe(e.reason);
+        if (e.reason != PayrollError::UnknownEmployee) {
+            cout << ", " << e.currentSalary << " -> " << e.rejectedSalary;
+        }
+        cout << endl;
+    }
+    for (const Employee& e : small.employees()) {
+        cout << e.getName() << ": $" << e.getSalary() << endl;
+    }
+
+    // Usage: ./a.out [employees]
+    size_t n = argc > 1 ? stoull(argv[1]) : 5'000'000;
+    Payroll company;
+    vector<int> everyone(n);
+    for (size_t i = 0; i < n; ++i) {
+        everyone[i] = int(i);
+        company.hire(Employee("Employee " + to_string(i), int(i), 40'000.0 + double(i % 50'000)));
+    }
+
+    ofstream devNull("/dev/null");
+    auto t0 = chrono::steady_clock::now();
+    for (int id : everyone) {
+        Employee& e = company.find(id);
+        e.setSalary(round(e.getSalary() * 1.03 * 100.0) / 100.0, devNull);
+    }
+    auto t1 = chrono::steady_clock::now();
+    PayrollResult bulk = company.applyRaise(everyone, 3.0);
+    auto t2 = chrono::steady_clock::now();
+
+    cout << "\n3% raise for " << n << " employees" << endl;
+    cout << "  setSalary loop (logging to /dev/null): " << chrono::duration<double>(t1 - t0).count() * 1e3 << " ms"
+         << endl;
+    cout << "  applyRaise:                            " << chrono::duration<double>(t2 - t1).count() * 1e3
+         << " ms, " << bulk.rejectedCount() << " rejected" << endl;
+
+    return 0;
+}
@@ -0,0 +1,268 @@
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+using namespace std;
+
+// Flat open-addressing hash index from employee id to the slot (row) that
+// holds that employee, e.g. an index into a vector<Employee> or an
+// EmployeeTable row from 5_employee_table.cpp.
+//
+// Layout, in the style of SwissTable:
+//   * slots[]  -- (id, row) pairs, 8 bytes each, no per-entry allocation.
+//   * control[] -- one byte per slot: Empty, Deleted, or a 7-bit tag taken
+//     from the id's hash.
+// Slots are probed 16 at a time. One SSE2 compare checks all 16 tags of a
+// group against the tag we are looking for, so most lookups touch one
+// control group and one slot.
+class EmployeeIdIndex {
+public:
+    using Row = uint32_t;
+
+private:
+    static constexpr int8_t Empty = int8_t(0x80);   // -128
+    static constexpr int8_t Deleted = int8_t(0xFE); // -2
+    static constexpr size_t GroupSize = 16;
+
+    struct Slot {
+        int32_t id;
+        Row row;
+    };
+
+    vector<int8_t> control;
+    vector<Slot> slots;
+    size_t groupMask = 0; // groupCount - 1, groupCount a power of two
+    size_t used = 0;      // live entries
+    size_t tombstones = 0;
+
+    static uint64_t hashOf(int32_t id) {
+        uint64_t x = uint64_t(uint32_t(id)) * 0x9E3779B97F4A7C15ull;
+        return x ^ (x >> 29);
+    }
+    static int8_t tagOf(uint64_t h) { return int8_t(h & 0x7F); }
+    static size_t groupOf(uint64_t h) { return size_t(h >> 7); }
+
+    // Bit i set => control byte i of the group equals 'value'.
+    uint32_t matchByte(size_t group, int8_t value) const {
+        const int8_t* c = control.data() + group * GroupSize;
+#if defined(__SSE2__)
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c));
+        return uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(value))));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < GroupSize; ++i) {
+            mask |= uint32_t(c[i] == value) << i;
+        }
+        return mask;
+#endif
+    }
+
+    // Bit i set => control byte i is Empty or Deleted (both have the top bit set).
+    uint32_t matchFree(size_t group) const {
+        const int8_t* c = control.data() + group * GroupSize;
+#if defined(__SSE2__)
+        return uint32_t(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(c))));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < GroupSize; ++i) {
+            mask |= uint32_t(c[i] < 0) << i;
+        }
+        return mask;
+#endif
+    }
+
+    // Index of the slot holding 'id', or SIZE_MAX.
+    size_t locate(int32_t id) const {
+        if (slots.empty()) {
+            return SIZE_MAX;
+        }
+        uint64_t h = hashOf(id);
+        int8_t tag = tagOf(h);
+        size_t g = groupOf(h) & groupMask;
+        // Triangular probing over groups visits every group exactly once.
+        for (size_t step = 1;; ++step) {
+            for (uint32_t m = matchByte(g, tag); m; m &= m - 1) {
+                size_t i = g * GroupSize + size_t(__builtin_ctz(m));
+                if (slots[i].id == id) {
+                    return i;
+                }
+            }
+            if (matchByte(g, Empty)) {
+                return SIZE_MAX; // an empty slot ends every probe chain
+            }
+            g = (g + step) & groupMask;
+        }
+    }
+
+    void rehash(size_t newGroupCount) {
+        vector<int8_t> oldControl = move(control);
+        vector<Slot> oldSlots = move(slots);
+        control.assign(newGroupCount * GroupSize, Empty);
+        slots.assign(newGroupCount * GroupSize, Slot{0, 0});
+        groupMask = newGroupCount - 1;
+        used = 0;
+        tombstones = 0;
+        for (size_t i = 0; i < oldSlots.size(); ++i) {
+            if (oldControl[i] >= 0) {
+                insertNew(oldSlots[i].id, oldSlots[i].row);
+            }
+        }
+    }
+
+    // Caller guarantees 'id' is absent and there is room.
+    void insertNew(int32_t id, Row row) {
+        uint64_t h = hashOf(id);
+        size_t g = groupOf(h) & groupMask;
+        for (size_t step = 1;; ++step) {
+            if (uint32_t m = matchFree(g)) {
+                size_t i = g * GroupSize + size_t(__builtin_ctz(m));
+                tombstones -= control[i] == Deleted;
+                control[i] = tagOf(h);
+                slots[i] = Slot{id, row};
+                ++used;
+                return;
+            }
+            g = (g + step) & groupMask;
+        }
+    }
+
+public:
+    EmployeeIdIndex() = default;
+    explicit EmployeeIdIndex(size_t expected) { reserve(expected); }
+
+    void reserve(size_t expected) {
+        size_t groups = 1;
+        while (groups * GroupSize * 7 / 8 < expected) {
+            groups *= 2;
+        }
+        if (groups * GroupSize > slots.size()) {
+            rehash(groups);
+        }
+    }
+
+    size_t size() const { return used; }
+
+    // Inserts or updates. Returns true if the id was new.
+    bool insert(int32_t id, Row row) {
+        size_t i = locate(id);
+        if (i != SIZE_MAX) {
+            slots[i].row = row;
+            return false;
+        }
+        // Keep live entries + tombstones under 7/8 of capacity. If most of
+        // the load is tombstones, rebuild at the same size to clear them.
+        if ((used + tombstones + 1) * 8 > slots.size() * 7) {
+            size_t groups = max<size_t>(1, (groupMask + 1));
+            rehash(used * 2 + 2 > slots.size() * 7 / 8 ? groups * 2 : groups);
+        }
+        insertNew(id, row);
+        return true;
+    }
+
+    // Returns a pointer to the row for 'id', or nullptr.
+    const Row* find(int32_t id) const {
+        size_t i = locate(id);
+        return i == SIZE_MAX ? nullptr : &slots[i].row;
+    }
+
+    bool erase(int32_t id) {
+        size_t i = locate(id);
+        if (i == SIZE_MAX) {
+            return false;
+        }
+        control[i] = Deleted; // keeps later entries of the probe chain reachable
+        --used;
+        ++tombstones;
+        return true;
+    }
+
+    size_t memoryBytes() const { return control.size() + slots.size() * sizeof(Slot); }
+};
+
+// Lookups/sec for both containers at one size.
+void benchmark(size_t n, size_t lookups) {
+    mt19937_64 rng(n);
+    vector<int32_t> ids(n);
+    for (size_t i = 0; i < n; ++i) {
+        ids[i] = int32_t(rng() & 0x7FFFFFFF);
+    }
+    vector<int32_t> probes(lookups);
+    for (size_t i = 0; i < lookups; ++i) {
+        // 90% hits, 10% misses
+        probes[i] = i % 10 == 0 ? int32_t(rng() & 0x7FFFFFFF) : ids[rng() % n];
+    }
+
+    auto timeIt = [](auto body) {
+        auto start = chrono::steady_clock::now();
+        body();
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    };
+
+    EmployeeIdIndex flat;
+    double flatBuild = timeIt([&] {
+        for (size_t i = 0; i < n; ++i) flat.insert(ids[i], EmployeeIdIndex::Row(i));
+    });
+    uint64_t flatSum = 0;
+    double flatFind = timeIt([&] {
+        for (int32_t id : probes) {
+            const EmployeeIdIndex::Row* r = flat.find(id);
+            flatSum += r ? *r : 0;
+        }
+    });
+
+    unordered_map<int32_t, uint32_t> stdMap;
+    double stdBuild = timeIt([&] {
+        for (size_t i = 0; i < n; ++i) stdMap[ids[i]] = uint32_t(i);
+    });
+    uint64_t stdSum = 0;
+    double stdFind = timeIt([&] {
+        for (int32_t id : probes) {
+            auto it = stdMap.find(id);
+            stdSum += it == stdMap.end() ? 0 : it->second;
+        }
+    });
+
+    cout << n << " entries:" << endl;
+    cout << "  EmployeeIdIndex:    insert " << double(n) / flatBuild / 1e6 << " M/s, lookup "
+         << double(lookups) / flatFind / 1e6 << " M/s, " << flat.memoryBytes() / (1 << 20) << " MiB" << endl;
+    cout << "  std::unordered_map: insert " << double(n) / stdBuild / 1e6 << " M/s, lookup "
+         << double(lookups) / stdFind / 1e6 << " M/s" << (flatSum == stdSum ? "" : "  !! results differ") << endl;
+}
+
+int main(int argc, char* argv[]) {
+    EmployeeIdIndex index;
+    index.insert(1001, 0);
+    index.insert(1002, 1);
+    index.insert(1003, 2);
+    index.erase(1002);
+    cout << "1001 -> row " << *index.find(1001) << ", 1002 " << (index.find(1002) ? "found" : "erased")
+         << ", 1003 -> row " << *index.find(1003) << endl;
+
+    // Churn: insert/erase many times to exercise tombstone clean-up.
+    for (int round = 0; round < 50; ++round) {
+        for (int32_t id = 0; id < 10'000; ++id) index.insert(id + round * 10'000, uint32_t(id));
+        for (int32_t id = 0; id < 10'000; ++id) index.erase(id + round * 10'000);
+    }
+    cout << "After churn: " << index.size() << " entries, " << index.memoryBytes() / 1024 << " KiB" << endl << endl;
+
+    // Usage: ./a.out [sizes...]   e.g. ./a.out 1000000 100000000 (needs ~10 GB for the std::unordered_map side)
+    vector<size_t> sizes;
+    for (int i = 1; i < argc; ++i) {
+        sizes.push_back(stoull(argv[i]));
+    }
+    if (sizes.empty()) {
+        sizes = {1'000'000, 10'000'000};
+    }
+    for (size_t n : sizes) {
+        benchmark(n, 10'000'000);
+    }
+
+    return 0;
+}
@@ -0,0 +1,227 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std;
+
+// Counts every heap allocation made through operator new, so the benchmark
+// can report allocations per employee instead of guessing.
+static atomic<size_t> allocationCount{0};
+
+void* operator new(size_t bytes) {
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(bytes ? bytes : 1)) {
+        return p;
+    }
+    throw bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+// As written in 2_accessModifiers_Getters_Setters.cpp (minus the printing):
+// the name is copied into the parameter, copied again by the assignment, and
+// copied a third time by every getName() call.
+class EmployeeByValue {
+private:
+    string name;
+    int employeeID;
+    double salary;
+
+public:
+    EmployeeByValue(string empName, int empID, double empSalary) {
+        name = empName;
+        employeeID = empID;
+        salary = empSalary;
+    }
+
+    string getName() const { return name; }
+    int getEmployeeID() const { return employeeID; }
+    double getSalary() const { return salary; }
+};
+
+// Move-aware: the by-value parameter is moved into the member, so a caller
+// that passes an rvalue pays no copy at all and a caller that passes an
+// lvalue pays exactly one. getName() hands out a view of the stored string.
+class Employee {
+private:
+    string name;
+    int employeeID;
+    double salary;
+
+public:
+    Employee(string empName, int empID, double empSalary)
+        : name(move(empName)), employeeID(empID), salary(empSalary >= 0 ? empSalary : 0) {}
+
+    // The view is valid while this Employee is alive and unmodified.
+    string_view getName() const { return name; }
+    int getEmployeeID() const { return employeeID; }
+    double getSalary() const { return salary; }
+};
+
+// Append-only storage for many names. Names are copied into large shared
+// chunks, so a million employees cost a few dozen allocations instead of a
+// million. Views stay valid for the lifetime of the arena because chunks are
+// never moved or freed early. A name longer than a whole chunk gets a chunk
+// of its own; the shared chunk being filled stays current.
+class NameArena {
+private:
+    static constexpr size_t ChunkBytes = 1 << 20;
+    vector<unique_ptr<char[]>> chunks;
+    char* cursor = nullptr; // next free byte of the current shared chunk
+    size_t left = 0;        // free bytes after 'cursor'
+
+public:
+    string_view store(string_view text) {
+        if (text.empty()) {
+            return string_view();
+        }
+        if (text.size() > ChunkBytes) {
+            chunks.push_back(make_unique_for_overwrite<char[]>(text.size()));
+            memcpy(chunks.back().get(), text.data(), text.size());
+            return string_view(chunks.back().get(), text.size());
+        }
+        if (text.size() > left) {
+            chunks.push_back(make_unique_for_overwrite<char[]>(ChunkBytes));
+            cursor = chunks.back().get();
+            left = ChunkBytes;
+        }
+        char* dst = cursor;
+        memcpy(dst, text.data(), text.size());
+        cursor += text.size();
+        left -= text.size();
+        return string_view(dst, text.size());
+    }
+
+    size_t chunkCount() const { return chunks.size(); }
+};
+
+// Employee whose name lives in a NameArena. The object itself is 32 bytes
+// and owns no heap memory.
+class ArenaEmployee {
+private:
+    string_view name;
+    int employeeID;
+    double salary;
+
+public:
+    ArenaEmployee(NameArena& arena, string_view empName, int empID, double empSalary)
+        : name(arena.store(empName)), employeeID(empID), salary(empSalary >= 0 ? empSalary : 0) {}
+
+    string_view getName() const { return name; }
+    int getEmployeeID() const { return employeeID; }
+    double getSalary() const { return salary; }
+};
+
+struct Measurement {
+    size_t constructAllocs, queryAllocs;
+    double constructMs, queryMs;
+};
+
+template <typename Build, typename Query>
+Measurement measure(Build build, Query query) {
+    Measurement m{};
+    size_t a0 = allocationCount.load();
+    auto t0 = chrono::steady_clock::now();
+    build();
+    auto t1 = chrono::steady_clock::now();
+    size_t a1 = allocationCount.load();
+    query();
+    auto t2 = chrono::steady_clock::now();
+    m.constructAllocs = a1 - a0;
+    m.queryAllocs = allocationCount.load() - a1;
+    m.constructMs = chrono::duration<double>(t1 - t0).count() * 1e3;
+    m.queryMs = chrono::duration<double>(t2 - t1).count() * 1e3;
+    return m;
+}
+
+void report(const string& label, const Measurement& m, size_t n) {
+    cout << "  " << label << " construct: " << double(m.constructAllocs) / double(n) << " allocs/employee, "
+         << m.constructMs << " ms | getName(): " << double(m.queryAllocs) / double(n) << " allocs/call, "
+         << m.queryMs << " ms" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    Employee emp("Alice Smith-Montgomery", 1001, 60000.0);
+    string_view name = emp.getName();
+    cout << "Name: " << name << " (" << name.size() << " chars, no copy)" << endl;
+
+    // Edge cases: an empty name in a fresh arena, then a name bigger than a
+    // chunk followed by short ones, which must not spill into its chunk.
+    {
+        NameArena arena;
+        string_view empty = arena.store("");
+        string huge((1 << 20) + 1, 'x');
+        string_view big = arena.store(huge);
+        string_view a = arena.store("Bob"), b = arena.store("Carol");
+        bool ok = empty.empty() && big == huge && a == "Bob" && b == "Carol";
+        cout << "Arena edge cases " << (ok ? "ok" : "FAILED") << " (" << arena.chunkCount() << " chunks)" << endl;
+    }
+
+    // Usage: ./a.out [employees]
+    size_t n = argc > 1 ? stoull(argv[1]) : 10'000'000;
+
+    // Names longer than the small-string buffer, built up front so their
+    // allocations are not charged to any variant.
+    auto makeNames = [n] {
+        vector<string> names;
+        names.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            names.push_back("Employee Number " + to_string(i));
+        }
+        return names;
+    };
+
+    cout << "\nConstructing and querying " << n << " employees" << endl;
+    size_t checksum = 0;
+    {
+        vector<string> names = makeNames();
+        vector<EmployeeByValue> staff;
+        Measurement m = measure(
+            [&] {
+                staff.reserve(n);
+                for (size_t i = 0; i < n; ++i) staff.emplace_back(names[i], int(i), 50'000.0);
+            },
+            [&] {
+                for (const EmployeeByValue& e : staff) checksum += e.getName().size();
+            });
+        report("by value (original)  ", m, n);
+    }
+    {
+        vector<string> names = makeNames();
+        vector<Employee> staff;
+        Measurement m = measure(
+            [&] {
+                staff.reserve(n);
+                for (size_t i = 0; i < n; ++i) staff.emplace_back(move(names[i]), int(i), 50'000.0);
+            },
+            [&] {
+                for (const Employee& e : staff) checksum += e.getName().size();
+            });
+        report("move + string_view   ", m, n);
+    }
+    {
+        vector<string> names = makeNames();
+        NameArena arena;
+        vector<ArenaEmployee> staff;
+        Measurement m = measure(
+            [&] {
+                staff.reserve(n);
+                for (size_t i = 0; i < n; ++i) staff.emplace_back(arena, names[i], int(i), 50'000.0);
+            },
+            [&] {
+                for (const ArenaEmployee& e : staff) checksum += e.getName().size();
+            });
+        report("shared NameArena     ", m, n);
+        cout << "  (arena used " << arena.chunkCount() << " chunks; sizeof(ArenaEmployee) = " << sizeof(ArenaEmployee)
+             << " vs sizeof(Employee) = " << sizeof(Employee) << ")" << endl;
+    }
+    cout << "checksum " << checksum << endl;
+
+    return 0;
+}
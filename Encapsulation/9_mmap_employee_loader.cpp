@@ -0,0 +1,286 @@
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+using namespace std;
+
+// Columnar employees, as in 5_employee_table.cpp, with names packed into one
+// byte column: name i is nameBytes[nameOffsets[i] .. nameOffsets[i + 1]).
+// Loading therefore never creates a std::string per row.
+class EmployeeColumns {
+private:
+    vector<int> ids;
+    vector<double> salaries;
+    vector<uint64_t> nameOffsets{0};
+    vector<char> nameBytes;
+
+public:
+    void add(int id, string_view name, double salary) {
+        ids.push_back(id);
+        salaries.push_back(salary);
+        nameBytes.insert(nameBytes.end(), name.begin(), name.end());
+        nameOffsets.push_back(nameBytes.size());
+    }
+
+    // Appends all rows of 'other' after ours, preserving order.
+    void append(const EmployeeColumns& other) {
+        uint64_t base = nameBytes.size();
+        ids.insert(ids.end(), other.ids.begin(), other.ids.end());
+        salaries.insert(salaries.end(), other.salaries.begin(), other.salaries.end());
+        nameBytes.insert(nameBytes.end(), other.nameBytes.begin(), other.nameBytes.end());
+        for (size_t i = 1; i < other.nameOffsets.size(); ++i) {
+            nameOffsets.push_back(base + other.nameOffsets[i]);
+        }
+    }
+
+    void reserve(size_t rows, size_t bytesOfNames) {
+        ids.reserve(rows);
+        salaries.reserve(rows);
+        nameOffsets.reserve(rows + 1);
+        nameBytes.reserve(bytesOfNames);
+    }
+
+    size_t size() const { return ids.size(); }
+    int getEmployeeID(size_t row) const { return ids[row]; }
+    double getSalary(size_t row) const { return salaries[row]; }
+    string_view getName(size_t row) const {
+        return string_view(nameBytes.data() + nameOffsets[row], nameOffsets[row + 1] - nameOffsets[row]);
+    }
+};
+
+// Fixed-size binary row: 64 bytes, so row i starts at byte 64 * i.
+struct EmployeeRecord {
+    int32_t id;
+    uint16_t nameLength;
+    char name[50];
+    double salary;
+};
+static_assert(sizeof(EmployeeRecord) == 64, "binary employee format is fixed-size");
+
+class MappedFile {
+private:
+    const char* base = nullptr;
+    size_t length = 0;
+
+public:
+    explicit MappedFile(const string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        struct stat st;
+        if (fd < 0 || ::fstat(fd, &st) != 0) {
+            throw runtime_error("MappedFile: cannot open " + path);
+        }
+        length = size_t(st.st_size);
+        if (length > 0) {
+            void* p = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                throw runtime_error("MappedFile: mmap failed for " + path);
+            }
+            ::madvise(p, length, MADV_SEQUENTIAL);
+            base = static_cast<const char*>(p);
+        }
+        ::close(fd);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+        if (base) {
+            ::munmap(const_cast<char*>(base), length);
+        }
+    }
+
+    string_view bytes() const { return string_view(base, length); }
+};
+
+// First position in [p, end) holding ',' or '\n', or end. Checks 16 bytes
+// per step with SSE2.
+inline const char* findDelimiter(const char* p, const char* end) {
+#if defined(__SSE2__)
+    const __m128i comma = _mm_set1_epi8(','), newline = _mm_set1_epi8('\n');
+    for (; p + 16 <= end; p += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, comma), _mm_cmpeq_epi8(chunk, newline)));
+        if (mask) {
+            return p + __builtin_ctz(unsigned(mask));
+        }
+    }
+#endif
+    while (p < end && *p != ',' && *p != '\n') {
+        ++p;
+    }
+    return p;
+}
+
+// Parses "id,name,salary\n" rows (CRLF endings accepted). Names may not
+// contain commas. Malformed rows, including numbers with trailing junk, are
+// skipped and counted.
+size_t parseCsv(string_view text, EmployeeColumns& out) {
+    size_t bad = 0;
+    const char* p = text.data();
+    const char* end = p + text.size();
+    while (p < end) {
+        const char* f1 = findDelimiter(p, end);
+        const char* f2 = f1 < end && *f1 == ',' ? findDelimiter(f1 + 1, end) : f1;
+        const char* f3 = f2 < end && *f2 == ',' ? findDelimiter(f2 + 1, end) : f2;
+        int id = 0;
+        double salary = 0;
+        // Both numbers must fill their whole field; a CRLF line ends in '\r'.
+        const char* salaryEnd = f3 > f2 + 1 && f3[-1] == '\r' ? f3 - 1 : f3;
+        bool ok = f1 < end && *f1 == ',' && f2 < end && *f2 == ',' && (f3 == end || *f3 == '\n');
+        if (ok) {
+            auto idParse = from_chars(p, f1, id);
+            auto salaryParse = from_chars(f2 + 1, salaryEnd, salary);
+            ok = idParse.ec == errc() && idParse.ptr == f1 && salaryParse.ec == errc() &&
+                 salaryParse.ptr == salaryEnd && salary >= 0;
+        }
+        if (ok) {
+            out.add(id, string_view(f1 + 1, size_t(f2 - f1 - 1)), salary);
+        } else {
+            ++bad;
+            f3 = findDelimiter(f3, end);
+            while (f3 < end && *f3 != '\n') f3 = findDelimiter(f3 + 1, end);
+        }
+        p = f3 + 1;
+    }
+    return bad;
+}
+
+size_t parseBinary(string_view bytes, EmployeeColumns& out) {
+    size_t bad = 0;
+    for (size_t off = 0; off + sizeof(EmployeeRecord) <= bytes.size(); off += sizeof(EmployeeRecord)) {
+        EmployeeRecord r;
+        memcpy(&r, bytes.data() + off, sizeof(r));
+        if (r.nameLength > sizeof(r.name) || !(r.salary >= 0)) {
+            ++bad;
+            continue;
+        }
+        out.add(r.id, string_view(r.name, r.nameLength), r.salary);
+    }
+    return bad;
+}
+
+// Splits the file into one piece per thread (on row boundaries), parses the
+// pieces in parallel into private columns, then concatenates them in order.
+EmployeeColumns loadEmployees(const string& path, bool binary, unsigned threads, size_t& malformed) {
+    MappedFile file(path);
+    string_view all = file.bytes();
+    vector<string_view> pieces;
+    size_t start = 0;
+    for (unsigned t = 1; t <= threads; ++t) {
+        size_t end = all.size() * t / threads;
+        if (binary) {
+            end = end / sizeof(EmployeeRecord) * sizeof(EmployeeRecord);
+        } else if (t < threads) {
+            size_t nl = all.find('\n', end);
+            end = nl == string_view::npos ? all.size() : nl + 1;
+        }
+        end = max(end, start);
+        pieces.push_back(all.substr(start, end - start));
+        start = end;
+    }
+
+    vector<EmployeeColumns> parts(threads);
+    vector<size_t> bad(threads, 0);
+    vector<thread> pool;
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            size_t rowsGuess = binary ? pieces[t].size() / sizeof(EmployeeRecord) : pieces[t].size() / 32;
+            parts[t].reserve(rowsGuess, rowsGuess * 24);
+            bad[t] = binary ? parseBinary(pieces[t], parts[t]) : parseCsv(pieces[t], parts[t]);
+        });
+    }
+    for (auto& th : pool) {
+        th.join();
+    }
+
+    if (threads == 1) {
+        malformed = bad[0];
+        return move(parts[0]);
+    }
+    EmployeeColumns merged;
+    size_t rows = 0;
+    for (const EmployeeColumns& part : parts) {
+        rows += part.size();
+    }
+    merged.reserve(rows, rows * 24);
+    malformed = 0;
+    for (unsigned t = 0; t < threads; ++t) {
+        merged.append(parts[t]);
+        parts[t] = EmployeeColumns(); // release as we go to keep peak RSS down
+        malformed += bad[t];
+    }
+    return merged;
+}
+
+size_t peakRssMiB() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return size_t(usage.ru_maxrss) / 1024; // ru_maxrss is in KiB on Linux
+}
+
+void writeSampleFiles(const string& csvPath, const string& binPath, size_t rows) {
+    FILE* csv = fopen(csvPath.c_str(), "wb");
+    FILE* bin = fopen(binPath.c_str(), "wb");
+    if (!csv || !bin) {
+        throw runtime_error("cannot create sample employee files");
+    }
+    mt19937_64 rng(3);
+    for (size_t i = 0; i < rows; ++i) {
+        EmployeeRecord r{};
+        r.id = int32_t(100'000 + i);
+        r.nameLength = uint16_t(snprintf(r.name, sizeof(r.name), "Employee %zu Surname%u", i, unsigned(rng() % 1000)));
+        r.salary = double(30'000 + rng() % 120'000) + double(rng() % 100) / 100.0;
+        fprintf(csv, "%d,%.*s,%.2f\n", r.id, int(r.nameLength), r.name, r.salary);
+        fwrite(&r, sizeof(r), 1, bin);
+    }
+    fclose(csv);
+    fclose(bin);
+}
+
+int main(int argc, char* argv[]) {
+    // Usage: ./a.out [rows] [threads]
+    size_t rows = argc > 1 ? stoull(argv[1]) : 10'000'000;
+    unsigned threads = argc > 2 ? unsigned(stoul(argv[2])) : max(1u, thread::hardware_concurrency());
+    string csvPath = "/tmp/employees.csv", binPath = "/tmp/employees.bin";
+    writeSampleFiles(csvPath, binPath, rows);
+    size_t rssBefore = peakRssMiB();
+
+    for (bool binary : {false, true}) {
+        const string& path = binary ? binPath : csvPath;
+        struct stat st;
+        ::stat(path.c_str(), &st);
+        size_t malformed = 0;
+        auto t0 = chrono::steady_clock::now();
+        EmployeeColumns table = loadEmployees(path, binary, threads, malformed);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+
+        cout << (binary ? "binary" : "csv   ") << ": " << table.size() << " rows (" << malformed << " malformed) in "
+             << seconds * 1e3 << " ms, " << double(st.st_size) / 1e9 / seconds << " GB/s" << endl;
+        cout << "        last row: " << table.getEmployeeID(table.size() - 1) << ", "
+             << table.getName(table.size() - 1) << ", $" << table.getSalary(table.size() - 1) << endl;
+    }
+    cout << "peak RSS " << peakRssMiB() << " MiB (" << rssBefore << " MiB before loading)" << endl;
+
+    ::unlink(csvPath.c_str());
+    ::unlink(binPath.c_str());
+    return 0;
+}
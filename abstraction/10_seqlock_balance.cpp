@@ -0,0 +1,183 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+using Amount = int64_t; // whole cents, as in 3_fixed_point_money.cpp
+
+// What a reader sees: the balance together with the fields that must agree
+// with it. A reader must never observe a balance from one transaction paired
+// with the transaction count from another.
+struct BalanceSnapshot {
+    Amount balance;
+    Amount heldFunds;        // reserved by pending card authorisations
+    uint64_t transactionCount;
+
+    Amount available() const { return balance - heldFunds; }
+};
+
+// BankAccount whose getBalance() is a sequence-lock read. Writers bump the
+// sequence to an odd value, update the fields, then bump it back to even.
+// Readers copy the fields and retry if the sequence was odd or changed while
+// they were copying. Readers take no lock and write no shared memory, so any
+// number of them can run without slowing each other or the writer down.
+class BankAccount {
+private:
+    alignas(64) atomic<uint64_t> sequence{0};
+    // Fields are atomics accessed with relaxed ordering only so that the racy
+    // reads are well-defined C++; the sequence number provides the ordering.
+    atomic<Amount> balance;
+    atomic<Amount> heldFunds{0};
+    atomic<uint64_t> transactionCount{0};
+    mutex writerLock; // serialises writers only; readers never touch it
+
+    template <typename Update>
+    void write(Update update) {
+        lock_guard<mutex> guard(writerLock);
+        uint64_t s = sequence.load(memory_order_relaxed);
+        sequence.store(s + 1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+        update();
+        sequence.store(s + 2, memory_order_release);
+    }
+
+public:
+    explicit BankAccount(Amount initialBalance) : balance(initialBalance >= 0 ? initialBalance : 0) {}
+
+    bool deposit(Amount amount) {
+        if (amount <= 0) {
+            return false;
+        }
+        write([&] {
+            balance.store(balance.load(memory_order_relaxed) + amount, memory_order_relaxed);
+            transactionCount.store(transactionCount.load(memory_order_relaxed) + 1, memory_order_relaxed);
+        });
+        return true;
+    }
+
+    bool withdraw(Amount amount) {
+        bool ok = false;
+        if (amount <= 0) {
+            return false;
+        }
+        write([&] {
+            Amount b = balance.load(memory_order_relaxed);
+            if (amount <= b - heldFunds.load(memory_order_relaxed)) {
+                balance.store(b - amount, memory_order_relaxed);
+                transactionCount.store(transactionCount.load(memory_order_relaxed) + 1, memory_order_relaxed);
+                ok = true;
+            }
+        });
+        return ok;
+    }
+
+    void hold(Amount amount) {
+        write([&] { heldFunds.store(heldFunds.load(memory_order_relaxed) + amount, memory_order_relaxed); });
+    }
+
+    BalanceSnapshot getBalance() const {
+        for (;;) {
+            uint64_t before = sequence.load(memory_order_acquire);
+            BalanceSnapshot s{balance.load(memory_order_relaxed), heldFunds.load(memory_order_relaxed),
+                              transactionCount.load(memory_order_relaxed)};
+            atomic_thread_fence(memory_order_acquire);
+            if ((before & 1) == 0 && sequence.load(memory_order_relaxed) == before) {
+                return s;
+            }
+        }
+    }
+};
+
+// Baseline: the same account behind a reader/writer lock. Readers still write
+// to the lock's shared counter, so they contend on its cache line.
+class RwLockBankAccount {
+private:
+    mutable shared_mutex lock;
+    BalanceSnapshot state;
+
+public:
+    explicit RwLockBankAccount(Amount initialBalance) : state{initialBalance, 0, 0} {}
+
+    bool deposit(Amount amount) {
+        unique_lock<shared_mutex> guard(lock);
+        state.balance += amount;
+        ++state.transactionCount;
+        return true;
+    }
+
+    BalanceSnapshot getBalance() const {
+        shared_lock<shared_mutex> guard(lock);
+        return state;
+    }
+};
+
+// 'readers' threads call getBalance() in a loop while one writer deposits 1
+// cent at a time. Every deposit changes balance and transactionCount
+// together, so a torn read would show balance - initial != transactionCount.
+template <typename Account>
+void benchmark(const string& label, int readers, chrono::milliseconds duration) {
+    const Amount initial = 1'000'000;
+    Account account(initial);
+    atomic<bool> stop{false};
+    atomic<uint64_t> totalReads{0}, tornReads{0};
+    uint64_t writes = 0;
+
+    vector<thread> threads;
+    for (int r = 0; r < readers; ++r) {
+        threads.emplace_back([&] {
+            uint64_t reads = 0, torn = 0;
+            while (!stop.load(memory_order_relaxed)) {
+                BalanceSnapshot s = account.getBalance();
+                torn += uint64_t(s.balance - initial) != s.transactionCount;
+                ++reads;
+            }
+            totalReads.fetch_add(reads);
+            tornReads.fetch_add(torn);
+        });
+    }
+    thread writer([&] {
+        while (!stop.load(memory_order_relaxed)) {
+            account.deposit(1);
+            ++writes;
+            this_thread::yield(); // keep writes far rarer than reads
+        }
+    });
+
+    this_thread::sleep_for(duration);
+    stop.store(true);
+    writer.join();
+    for (auto& t : threads) {
+        t.join();
+    }
+    double seconds = chrono::duration<double>(duration).count();
+    cout << "  " << label << " readers " << readers << ": " << double(totalReads.load()) / seconds / 1e6
+         << " M reads/s, " << double(writes) / seconds / 1e6 << " M writes/s, torn reads " << tornReads.load() << endl;
+}
+
+int main(int argc, char* argv[]) {
+    BankAccount myAccount(100'000);
+    myAccount.deposit(50'000);
+    myAccount.hold(30'000);
+    myAccount.withdraw(200'000); // rejected: only 120000 available
+    BalanceSnapshot s = myAccount.getBalance();
+    cout << "Balance " << s.balance << ", held " << s.heldFunds << ", available " << s.available() << " after "
+         << s.transactionCount << " transactions" << endl;
+
+    // Usage: ./a.out [maxReaders] [millisecondsPerRun]
+    int maxReaders = argc > 1 ? stoi(argv[1]) : int(max(2u, thread::hardware_concurrency()));
+    chrono::milliseconds duration(argc > 2 ? stoi(argv[2]) : 500);
+
+    cout << "\nReader scaling with one concurrent writer" << endl;
+    for (int readers = 1; readers <= maxReaders; readers *= 2) {
+        benchmark<BankAccount>("seqlock", readers, duration);
+        benchmark<RwLockBankAccount>("rwlock ", readers, duration);
+    }
+
+    return 0;
+}
@@ -0,0 +1,306 @@
+#include <algorithm>
+#include <barrier>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+using namespace std;
+
+using Amount = int64_t; // whole cents, as in 3_fixed_point_money.cpp
+
+struct Transaction {
+    uint32_t accountId;
+    bool isDeposit;
+    Amount amount;
+};
+
+// Binary input is a flat array of these, written by the same program.
+struct BinaryRecord {
+    uint32_t accountId;
+    uint8_t kind; // 'D' or 'W'
+    uint8_t padding[3];
+    Amount amount;
+};
+static_assert(sizeof(BinaryRecord) == 16, "binary replay format is fixed-size");
+
+// Read-only mmap of the whole input file.
+class MappedFile {
+private:
+    const char* base = nullptr;
+    size_t length = 0;
+
+public:
+    explicit MappedFile(const string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        struct stat st;
+        if (fd < 0 || ::fstat(fd, &st) != 0) {
+            throw runtime_error("MappedFile: cannot open " + path);
+        }
+        length = size_t(st.st_size);
+        if (length > 0) {
+            void* p = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                throw runtime_error("MappedFile: mmap failed for " + path);
+            }
+            ::madvise(p, length, MADV_SEQUENTIAL);
+            base = static_cast<const char*>(p);
+        }
+        ::close(fd);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+        if (base) {
+            ::munmap(const_cast<char*>(base), length);
+        }
+    }
+
+    string_view bytes() const { return string_view(base, length); }
+};
+
+// Accounts are handed to workers in blocks of PartitionBlock consecutive ids,
+// so each worker writes whole runs of cache lines of the balance array
+// instead of every worker touching every line (which accountId % workers
+// would do).
+constexpr uint32_t PartitionBlock = 64;
+
+inline size_t partitionOf(uint32_t accountId, size_t workers) { return accountId / PartitionBlock % workers; }
+
+// Parses "<accountId>,<D|W>,<dollars>[.<cents>]" lines, e.g. "1042,W,19.99",
+// with optional CRLF endings. Lines that are malformed, name an account
+// outside [0, accounts) or give an amount too large for Amount are counted
+// and skipped.
+size_t parseCsvChunk(string_view text, size_t accounts, vector<vector<Transaction>>& partitions) {
+    size_t bad = 0;
+    const char* p = text.data();
+    const char* end = p + text.size();
+    while (p < end) {
+        const char* eol = static_cast<const char*>(memchr(p, '\n', size_t(end - p)));
+        if (!eol) {
+            eol = end;
+        }
+        const char* stop = eol > p && eol[-1] == '\r' ? eol - 1 : eol;
+        Transaction t{};
+        uint64_t dollars = 0, cents = 0;
+        auto [q, ec] = from_chars(p, stop, t.accountId);
+        bool ok = ec == errc() && t.accountId < accounts && q + 2 < stop && q[0] == ',' &&
+                  (q[1] == 'D' || q[1] == 'W') && q[2] == ',';
+        if (ok) {
+            t.isDeposit = q[1] == 'D';
+            auto [r, ec2] = from_chars(q + 3, stop, dollars);
+            ok = ec2 == errc() && dollars <= uint64_t(INT64_MAX - 99) / 100;
+            if (ok && r < stop && *r == '.') {
+                const char* c = r + 1;
+                auto [e, ec3] = from_chars(c, stop, cents);
+                ok = stop - c == 2 && ec3 == errc() && e == stop;
+            } else if (ok && r != stop) {
+                ok = false;
+            }
+        }
+        if (ok) {
+            t.amount = Amount(dollars * 100 + cents);
+            partitions[partitionOf(t.accountId, partitions.size())].push_back(t);
+        } else if (stop != p) {
+            ++bad;
+        }
+        p = eol + 1;
+    }
+    return bad;
+}
+
+size_t parseBinaryChunk(string_view bytes, size_t accounts, vector<vector<Transaction>>& partitions) {
+    size_t bad = 0;
+    size_t records = bytes.size() / sizeof(BinaryRecord);
+    for (size_t i = 0; i < records; ++i) {
+        BinaryRecord r;
+        memcpy(&r, bytes.data() + i * sizeof(BinaryRecord), sizeof(r));
+        if (r.accountId >= accounts || (r.kind != 'D' && r.kind != 'W') || r.amount < 0) {
+            ++bad;
+            continue;
+        }
+        partitions[partitionOf(r.accountId, partitions.size())].push_back(
+            Transaction{r.accountId, r.kind == 'D', r.amount});
+    }
+    return bad;
+}
+
+// Streaming two-stage replay. The file is cut into chunks (on line or record
+// boundaries) and processed a window of 'workers' chunks at a time:
+//   * parse: each worker parses one chunk of the window, sorting its
+//     transactions into one bucket per partition;
+//   * apply: worker w applies bucket w of every chunk in the window, in
+//     file order.
+// In step s the workers parse window s while applying window s - 1, with a
+// barrier between steps. Only two windows of parsed transactions exist at
+// any time, so memory stays bounded however long the file is.
+// Every account belongs to exactly one worker, and that worker sees its
+// transactions in file order, so per-account ordering is preserved without
+// any locking on the balances.
+struct ReplayStats {
+    size_t transactions = 0;
+    size_t rejected = 0;  // withdrawals that exceeded the balance
+    size_t malformed = 0; // unparseable lines/records or unknown accounts
+};
+
+// 'workers' below 1 is treated as 1.
+ReplayStats replay(string_view input, bool binary, vector<Amount>& balances, unsigned workers) {
+    workers = max(workers, 1u);
+    const size_t targetChunk = 8 << 20;
+    vector<string_view> chunks;
+    size_t pos = 0;
+    while (pos < input.size()) {
+        size_t end = min(input.size(), pos + targetChunk);
+        if (binary) {
+            end = pos + (end - pos) / sizeof(BinaryRecord) * sizeof(BinaryRecord);
+            if (end == pos) {
+                break; // trailing partial record, counted below
+            }
+        } else if (end < input.size()) {
+            size_t nl = input.find('\n', end);
+            end = nl == string_view::npos ? input.size() : nl + 1;
+        }
+        chunks.push_back(input.substr(pos, end - pos));
+        pos = end;
+    }
+
+    size_t windows = (chunks.size() + workers - 1) / workers;
+    // window[s % 2][i][w] = transactions from chunk s * workers + i for worker w.
+    using Window = vector<vector<vector<Transaction>>>;
+    Window window[2] = {Window(workers, vector<vector<Transaction>>(workers)),
+                        Window(workers, vector<vector<Transaction>>(workers))};
+    vector<ReplayStats> perWorker(workers);
+    barrier stepDone(workers);
+
+    vector<thread> pool;
+    for (unsigned w = 0; w < workers; ++w) {
+        pool.emplace_back([&, w] {
+            ReplayStats& stats = perWorker[w];
+            for (size_t step = 0; step <= windows; ++step) {
+                size_t c = step * workers + w;
+                if (step < windows && c < chunks.size()) {
+                    auto& buckets = window[step % 2][w];
+                    stats.malformed += binary ? parseBinaryChunk(chunks[c], balances.size(), buckets)
+                                              : parseCsvChunk(chunks[c], balances.size(), buckets);
+                }
+                if (step > 0) {
+                    for (auto& buckets : window[(step - 1) % 2]) {
+                        for (const Transaction& t : buckets[w]) {
+                            Amount& b = balances[t.accountId];
+                            if (t.isDeposit) {
+                                b += t.amount;
+                            } else if (t.amount <= b) {
+                                b -= t.amount;
+                            } else {
+                                ++stats.rejected;
+                            }
+                            ++stats.transactions;
+                        }
+                        buckets[w].clear(); // keeps capacity for the next window
+                    }
+                }
+                stepDone.arrive_and_wait();
+            }
+        });
+    }
+    for (auto& t : pool) {
+        t.join();
+    }
+
+    ReplayStats total;
+    total.malformed = pos < input.size() ? 1 : 0;
+    for (const ReplayStats& s : perWorker) {
+        total.transactions += s.transactions;
+        total.rejected += s.rejected;
+        total.malformed += s.malformed;
+    }
+    return total;
+}
+
+// Writes a synthetic day of transactions in both formats.
+void generateInputs(const string& csvPath, const string& binPath, size_t count, uint32_t accounts) {
+    FILE* csv = fopen(csvPath.c_str(), "wb");
+    FILE* bin = fopen(binPath.c_str(), "wb");
+    if (!csv || !bin) {
+        throw runtime_error("cannot create replay input files");
+    }
+    mt19937_64 rng(99);
+    char line[64];
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t id = uint32_t(rng() % accounts);
+        bool deposit = rng() % 3 != 0;
+        Amount cents = Amount(rng() % 50'000);
+        int n = snprintf(line, sizeof(line), "%u,%c,%lld.%02lld\n", id, deposit ? 'D' : 'W',
+                         (long long)(cents / 100), (long long)(cents % 100));
+        fwrite(line, 1, size_t(n), csv);
+        BinaryRecord r{id, uint8_t(deposit ? 'D' : 'W'), {0, 0, 0}, cents};
+        fwrite(&r, sizeof(r), 1, bin);
+    }
+    fclose(csv);
+    fclose(bin);
+}
+
+int main(int argc, char* argv[]) {
+    // Usage: ./a.out [transactions] [accounts] [workers]
+    size_t count = argc > 1 ? stoull(argv[1]) : 10'000'000;
+    uint32_t accounts = argc > 2 ? uint32_t(stoul(argv[2])) : 1'000'000;
+    unsigned workers = max(1u, argc > 3 ? unsigned(stoul(argv[3])) : thread::hardware_concurrency());
+
+    // CRLF endings are fine; unknown accounts, trailing junk and amounts that
+    // overflow 64-bit cents are not.
+    {
+        string sample = "1,D,10.00\r\n2,D,5\r\n1,W,2.50\n999,D,1.00\n2,W,1.0x\n1,D,184467440737095516.00\n";
+        vector<Amount> balances(3, 0);
+        ReplayStats s = replay(sample, false, balances, 2);
+        cout << "Sample: balances " << balances[1] << " / " << balances[2] << " cents, " << s.transactions
+             << " applied, " << s.malformed << " malformed" << endl;
+
+        // One whole binary record followed by half of another.
+        BinaryRecord r{1, 'D', {0, 0, 0}, 700};
+        string bytes(reinterpret_cast<const char*>(&r), sizeof(r));
+        bytes.append(bytes, 0, sizeof(r) / 2);
+        s = replay(bytes, true, balances, 0);
+        cout << "Binary sample: " << s.transactions << " applied, " << s.malformed << " malformed" << endl;
+    }
+
+    string csvPath = "/tmp/replay_input.csv", binPath = "/tmp/replay_input.bin";
+    generateInputs(csvPath, binPath, count, accounts);
+
+    vector<Amount> reference;
+    for (bool binary : {false, true}) {
+        MappedFile file(binary ? binPath : csvPath);
+        vector<Amount> balances(accounts, 0);
+        auto start = chrono::steady_clock::now();
+        ReplayStats s = replay(file.bytes(), binary, balances, workers);
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+        double mb = double(file.bytes().size()) / 1e6;
+        cout << (binary ? "binary" : "csv   ") << " replay, " << workers << " workers: " << mb / elapsed.count()
+             << " MB/s, " << double(s.transactions) / elapsed.count() / 1e6 << " M transactions/s (" << s.rejected
+             << " rejected, " << s.malformed << " malformed)" << endl;
+
+        if (reference.empty()) {
+            reference = balances;
+        } else {
+            cout << "Final balances " << (reference == balances ? "match" : "DIFFER") << " between formats" << endl;
+        }
+    }
+
+    ::unlink(csvPath.c_str());
+    ::unlink(binPath.c_str());
+    return 0;
+}
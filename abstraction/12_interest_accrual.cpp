@@ -0,0 +1,221 @@
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+using namespace std;
+
+using Amount = int64_t; // whole cents, as in 3_fixed_point_money.cpp
+
+// Tiered month-end rules. A balance falls into the highest tier whose
+// minBalance it reaches. Each tier pays interest at ratePpm (parts per
+// million of the positive balance, so 1'250 = 0.125% per month) and charges
+// a flat fee in cents.
+class RateTable {
+public:
+    static constexpr size_t MaxTiers = 8;
+    static constexpr int64_t MaxRatePpm = 1'000'000; // 100%, fits in 20 bits
+    // Keeps balance - fee in range for every balance on the AVX2 fast path
+    // (above -2^62), so that path never needs an overflow check.
+    static constexpr Amount MaxFee = Amount(1) << 61;
+
+private:
+    int64_t minBalances[MaxTiers];
+    int64_t rates[MaxTiers];
+    int64_t fees[MaxTiers];
+    size_t tiers = 0;
+
+public:
+    // The first tier must start at INT64_MIN so every balance has a tier.
+    void addTier(Amount minBalance, int64_t ratePpm, Amount fee) {
+        if (tiers == MaxTiers) {
+            throw length_error("RateTable: too many tiers");
+        }
+        if ((tiers == 0 && minBalance != INT64_MIN) || (tiers > 0 && minBalance <= minBalances[tiers - 1])) {
+            throw invalid_argument("RateTable: tiers must start at INT64_MIN and ascend");
+        }
+        if (ratePpm < 0 || ratePpm > MaxRatePpm || fee < 0 || fee > MaxFee) {
+            throw invalid_argument("RateTable: rate must be 0..100% and fee between 0 and 2^61 cents");
+        }
+        minBalances[tiers] = minBalance;
+        rates[tiers] = ratePpm;
+        fees[tiers] = fee;
+        ++tiers;
+    }
+
+    size_t size() const { return tiers; }
+    const int64_t* minBalanceData() const { return minBalances; }
+    const int64_t* rateData() const { return rates; }
+    const int64_t* feeData() const { return fees; }
+
+    size_t tierFor(Amount balance) const {
+        size_t t = 0;
+        for (size_t i = 1; i < tiers; ++i) {
+            t += balance >= minBalances[i];
+        }
+        return t;
+    }
+};
+
+// The rule, written once in exact integer arithmetic:
+//
+//   interest = round_half_up(max(balance, 0) * ratePpm / 1'000'000)
+//   result   = balance + interest - fee
+//
+// Every code path below must produce exactly this value.
+Amount accrueOne(Amount balance, const RateTable& table) {
+    size_t t = table.tierFor(balance);
+    __int128 positive = balance > 0 ? balance : 0;
+    Amount interest = Amount((positive * table.rateData()[t] + 500'000) / 1'000'000);
+    Amount result;
+    if (__builtin_add_overflow(balance, interest, &result) ||
+        __builtin_sub_overflow(result, table.feeData()[t], &result)) {
+        throw overflow_error("accrue: balance out of range");
+    }
+    return result;
+}
+
+void accrueScalar(Amount* balances, size_t n, const RateTable& table) {
+    for (size_t i = 0; i < n; ++i) {
+        balances[i] = accrueOne(balances[i], table);
+    }
+}
+
+#if defined(__x86_64__)
+// AVX2 kernel, four balances per step. AVX2 has neither a 64-bit multiply nor
+// integer division, so the fast path is limited to balances where both can be
+// done exactly with the tools it does have:
+//
+//   * -2^62 < balance < 2^30 (about $10.7M): the positive part fits in 32
+//     bits, so _mm256_mul_epu32 gives the exact 64-bit product, and that
+//     product (< 2^50) is exact as a double.
+//   * For x < 2^51, floor(double(x) / 1e6) equals the integer quotient: the
+//     rounding error of the division is below 2^-22, far less than the 1e-6
+//     gap between a non-integer quotient and the next integer.
+//   * interest < 2^30 and RateTable caps fees at 2^61, so
+//     balance + interest - fee stays inside int64 and cannot wrap.
+//
+// Lanes outside the fast range are redone with accrueOne(), so the output is
+// bit-identical to accrueScalar() for every input.
+__attribute__((target("avx2"))) void accrueAvx2(Amount* balances, size_t n, const RateTable& table) {
+    const __m256i fastMax = _mm256_set1_epi64x((int64_t(1) << 30) - 1);
+    const __m256i fastMin = _mm256_set1_epi64x(-(int64_t(1) << 62));
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi64x(1);
+    const __m256i half = _mm256_set1_epi64x(500'000);
+    const __m256d million = _mm256_set1_pd(1'000'000.0);
+    // 2^52 "magic number": for 0 <= x < 2^52, the double whose bit pattern is
+    // (x | bits(2^52)) equals 2^52 + x. Used to convert between int64 and
+    // double without AVX-512.
+    const __m256i magicBits = _mm256_set1_epi64x(0x4330000000000000);
+    const __m256d magic = _mm256_set1_pd(4503599627370496.0);
+
+    __m256i thresholds[RateTable::MaxTiers];
+    for (size_t t = 1; t < table.size(); ++t) {
+        thresholds[t] = _mm256_set1_epi64x(table.minBalanceData()[t]);
+    }
+    const long long* rates = reinterpret_cast<const long long*>(table.rateData());
+    const long long* fees = reinterpret_cast<const long long*>(table.feeData());
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(balances + i));
+
+        // tier = number of thresholds (beyond the first) that b reaches
+        __m256i tier = zero;
+        for (size_t t = 1; t < table.size(); ++t) {
+            __m256i below = _mm256_cmpgt_epi64(thresholds[t], b);
+            tier = _mm256_add_epi64(tier, _mm256_andnot_si256(below, one));
+        }
+        __m256i rate = _mm256_i64gather_epi64(rates, tier, 8);
+        __m256i fee = _mm256_i64gather_epi64(fees, tier, 8);
+
+        __m256i positive = _mm256_blendv_epi8(zero, b, _mm256_cmpgt_epi64(b, zero));
+        __m256i product = _mm256_add_epi64(_mm256_mul_epu32(positive, rate), half);
+
+        __m256d numerator = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(product, magicBits)), magic);
+        __m256d quotient = _mm256_floor_pd(_mm256_div_pd(numerator, million));
+        __m256i interest = _mm256_xor_si256(_mm256_castpd_si256(_mm256_add_pd(quotient, magic)), magicBits);
+
+        __m256i result = _mm256_sub_epi64(_mm256_add_epi64(b, interest), fee);
+
+        __m256i slow = _mm256_or_si256(_mm256_cmpgt_epi64(b, fastMax), _mm256_cmpgt_epi64(fastMin, b));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(balances + i), result);
+        int slowLanes = _mm256_movemask_pd(_mm256_castsi256_pd(slow));
+        if (slowLanes) {
+            // 'result' holds garbage for these lanes; recompute from the
+            // original balance, which is still in b.
+            alignas(32) int64_t original[4];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(original), b);
+            for (int lane = 0; lane < 4; ++lane) {
+                if (slowLanes & (1 << lane)) {
+                    balances[i + lane] = accrueOne(original[lane], table);
+                }
+            }
+        }
+    }
+    accrueScalar(balances + i, n - i, table);
+}
+#endif
+
+// Picks the best kernel this CPU supports.
+void accrue(Amount* balances, size_t n, const RateTable& table) {
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports("avx2")) {
+        accrueAvx2(balances, n, table);
+        return;
+    }
+#endif
+    accrueScalar(balances, n, table);
+}
+
+int main(int argc, char* argv[]) {
+    RateTable table;
+    table.addTier(INT64_MIN, 0, 2'500);      // overdrawn: $25 fee, no interest
+    table.addTier(0, 0, 500);                // under $1,000: $5 fee
+    table.addTier(100'000, 1'000, 0);        // $1,000+: 0.1% per month
+    table.addTier(10'000'000, 2'500, 0);     // $100,000+: 0.25% per month
+
+    for (Amount b : {Amount(-5'000), Amount(50'000), Amount(250'050), Amount(50'000'000)}) {
+        cout << "Balance " << b << " -> " << accrueOne(b, table) << " cents" << endl;
+    }
+
+    // Usage: ./a.out [balances]
+    size_t n = argc > 1 ? stoull(argv[1]) : 50'000'000;
+    mt19937_64 rng(2024);
+    vector<Amount> original(n);
+    for (Amount& b : original) {
+        // mostly ordinary balances, with a sprinkling of overdrawn and very large ones
+        uint64_t r = rng();
+        b = r % 100 == 0 ? -Amount(r % 1'000'000) : r % 1000 == 1 ? Amount(r % 4'000'000'000'000) : Amount(r % 20'000'000);
+    }
+
+    vector<Amount> scalar = original;
+    auto t0 = chrono::steady_clock::now();
+    accrueScalar(scalar.data(), n, table);
+    auto t1 = chrono::steady_clock::now();
+
+    vector<Amount> dispatched = original;
+    auto t2 = chrono::steady_clock::now();
+    accrue(dispatched.data(), n, table);
+    auto t3 = chrono::steady_clock::now();
+
+    chrono::duration<double> scalarTime = t1 - t0, fastTime = t3 - t2;
+    bool identical = memcmp(scalar.data(), dispatched.data(), n * sizeof(Amount)) == 0;
+    cout << "\nMonth-end accrual over " << n << " balances" << endl;
+    cout << "  scalar:     " << scalarTime.count() * 1e3 << " ms" << endl;
+    cout << "  dispatched: " << fastTime.count() * 1e3 << " ms"
+#if defined(__x86_64__)
+         << (__builtin_cpu_supports("avx2") ? " (AVX2)" : " (scalar fallback)")
+#endif
+         << endl;
+    cout << "  results " << (identical ? "bit-identical" : "DIFFER") << endl;
+
+    return identical ? 0 : 1;
+}
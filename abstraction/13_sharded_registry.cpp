@@ -0,0 +1,270 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+using Amount = int64_t; // whole cents, as in 3_fixed_point_money.cpp
+using AccountId = uint64_t;
+
+struct Operation {
+    AccountId id;
+    Amount amount; // > 0 deposits, < 0 withdraws -amount
+};
+
+// Spreads account ids evenly even when ids are sequential.
+inline uint64_t mixHash(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    return x;
+}
+
+// Applies one operation to a balance map with BankAccount's rules.
+inline bool applyTo(unordered_map<AccountId, Amount>& balances, const Operation& op) {
+    if (op.amount > 0) {
+        balances[op.id] += op.amount;
+        return true;
+    }
+    auto it = balances.find(op.id);
+    if (op.amount == 0 || it == balances.end() || -op.amount > it->second) {
+        return false;
+    }
+    it->second += op.amount;
+    return true;
+}
+
+// Account ids hash into a fixed number of shards. Each shard sits on its own
+// cache lines and has its own lock and its own map, so threads touching
+// different shards never contend.
+class ShardedRegistry {
+private:
+    struct alignas(64) Shard {
+        mutex lock;
+        unordered_map<AccountId, Amount> balances;
+    };
+    vector<Shard> shards;
+
+public:
+    explicit ShardedRegistry(size_t shardCount) : shards(shardCount) {}
+
+    size_t shardCount() const { return shards.size(); }
+    size_t shardOf(AccountId id) const { return mixHash(id) % shards.size(); }
+
+    // Locked entry points, safe from any thread.
+    bool apply(const Operation& op) {
+        Shard& s = shards[shardOf(op.id)];
+        lock_guard<mutex> guard(s.lock);
+        return applyTo(s.balances, op);
+    }
+
+    Amount getBalance(AccountId id) {
+        Shard& s = shards[shardOf(id)];
+        lock_guard<mutex> guard(s.lock);
+        auto it = s.balances.find(id);
+        return it == s.balances.end() ? 0 : it->second;
+    }
+
+    // Lock-free entry point for the thread that exclusively owns the shard
+    // (see ShardRouter). Calling it from anywhere else is a data race.
+    bool applyOwned(size_t shard, const Operation& op) { return applyTo(shards[shard].balances, op); }
+
+    Amount totalBalance() {
+        Amount total = 0;
+        for (Shard& s : shards) {
+            lock_guard<mutex> guard(s.lock);
+            for (auto& [id, balance] : s.balances) {
+                total += balance;
+            }
+        }
+        return total;
+    }
+};
+
+// Routes batches of operations to shard-owning threads. Owner thread k is
+// the only thread that ever touches shards k, k + owners, k + 2*owners, ...
+// so it applies operations without taking any shard lock. The only
+// synchronisation is one queue hand-off per sub-batch, not one per operation.
+class ShardRouter {
+private:
+    struct alignas(64) Owner {
+        mutex lock;
+        condition_variable ready;
+        deque<vector<Operation>> inbox;
+        thread worker;
+    };
+
+    ShardedRegistry& registry;
+    vector<Owner> owners;
+    atomic<size_t> outstanding{0}; // sub-batches queued but not yet applied
+    atomic<uint64_t> succeeded{0};
+    atomic<bool> stopping{false};
+
+    void run(size_t k) {
+        Owner& me = owners[k];
+        for (;;) {
+            vector<Operation> batch;
+            {
+                unique_lock<mutex> guard(me.lock);
+                me.ready.wait(guard, [&] { return stopping || !me.inbox.empty(); });
+                if (me.inbox.empty()) {
+                    return; // stopping and drained
+                }
+                batch = move(me.inbox.front());
+                me.inbox.pop_front();
+            }
+            uint64_t ok = 0;
+            for (const Operation& op : batch) {
+                ok += registry.applyOwned(registry.shardOf(op.id), op);
+            }
+            succeeded.fetch_add(ok, memory_order_relaxed);
+            outstanding.fetch_sub(1, memory_order_release);
+        }
+    }
+
+public:
+    ShardRouter(ShardedRegistry& reg, size_t ownerCount) : registry(reg), owners(ownerCount) {
+        for (size_t k = 0; k < owners.size(); ++k) {
+            owners[k].worker = thread(&ShardRouter::run, this, k);
+        }
+    }
+
+    ShardRouter(const ShardRouter&) = delete;
+    ShardRouter& operator=(const ShardRouter&) = delete;
+
+    // Splits 'ops' by owning thread, preserving order within each owner.
+    // Safe to call from several producer threads at once; each producer's
+    // operations reach every owner in the order that producer submitted them.
+    void submit(const vector<Operation>& ops) {
+        vector<vector<Operation>> parts(owners.size());
+        for (const Operation& op : ops) {
+            parts[registry.shardOf(op.id) % owners.size()].push_back(op);
+        }
+        for (size_t k = 0; k < owners.size(); ++k) {
+            if (parts[k].empty()) {
+                continue;
+            }
+            outstanding.fetch_add(1, memory_order_relaxed);
+            {
+                lock_guard<mutex> guard(owners[k].lock);
+                owners[k].inbox.push_back(move(parts[k]));
+            }
+            owners[k].ready.notify_one();
+        }
+    }
+
+    // Blocks until every submitted batch has been applied.
+    void drain() {
+        while (outstanding.load(memory_order_acquire) != 0) {
+            this_thread::yield();
+        }
+    }
+
+    uint64_t succeededCount() const { return succeeded.load(); }
+
+    ~ShardRouter() {
+        stopping = true;
+        for (Owner& o : owners) {
+            { lock_guard<mutex> guard(o.lock); } // no owner can miss the wake-up
+            o.ready.notify_one();
+            o.worker.join();
+        }
+    }
+};
+
+vector<Operation> makeWorkload(size_t count, uint64_t accounts, uint64_t seed) {
+    mt19937_64 rng(seed);
+    vector<Operation> ops(count);
+    for (Operation& op : ops) {
+        op.id = rng() % accounts;
+        op.amount = rng() % 4 == 0 ? -Amount(rng() % 5'000) : Amount(1 + rng() % 5'000);
+    }
+    return ops;
+}
+
+// 1, 2, 4, ... below maxThreads, then maxThreads itself, so the top count
+// is measured even when it is not a power of two.
+vector<int> threadCounts(int maxThreads) {
+    vector<int> counts;
+    for (int threads = 1; threads < maxThreads; threads *= 2) {
+        counts.push_back(threads);
+    }
+    counts.push_back(max(maxThreads, 1));
+    return counts;
+}
+
+int main(int argc, char* argv[]) {
+    ShardedRegistry demo(16);
+    demo.apply({42, 10'000});
+    demo.apply({42, -2'500});
+    demo.apply({7, -100}); // rejected: account 7 has no funds
+    cout << "Account 42: " << demo.getBalance(42) << " cents, account 7: " << demo.getBalance(7) << " cents" << endl;
+
+    // Usage: ./a.out [maxThreads] [operations] [accounts]
+    int maxThreads = argc > 1 ? stoi(argv[1]) : int(max(2u, thread::hardware_concurrency()));
+    size_t opsCount = argc > 2 ? stoull(argv[2]) : 4'000'000;
+    uint64_t accounts = argc > 3 ? stoull(argv[3]) : 1'000'000;
+    const size_t batchSize = 4096;
+
+    cout << "\nthreads  global lock  per-shard locks  routed (M ops/s)" << endl;
+    for (int threads : threadCounts(maxThreads)) {
+        vector<vector<Operation>> perThread;
+        for (int t = 0; t < threads; ++t) {
+            perThread.push_back(makeWorkload(opsCount / threads, accounts, 100 + t));
+        }
+
+        auto timeThreads = [&](auto body) {
+            vector<thread> pool;
+            auto start = chrono::steady_clock::now();
+            for (int t = 0; t < threads; ++t) {
+                pool.emplace_back(body, t);
+            }
+            for (auto& th : pool) {
+                th.join();
+            }
+            return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        };
+
+        ShardedRegistry global(1); // one shard == one global lock
+        double globalTime = timeThreads([&](int t) {
+            for (const Operation& op : perThread[t]) global.apply(op);
+        });
+
+        ShardedRegistry sharded(size_t(threads) * 16);
+        double shardedTime = timeThreads([&](int t) {
+            for (const Operation& op : perThread[t]) sharded.apply(op);
+        });
+
+        ShardedRegistry routedRegistry(size_t(threads) * 16);
+        double routedTime;
+        {
+            // Same producers as the other columns: each thread submits its
+            // own operations in batches, and the owners apply them.
+            ShardRouter router(routedRegistry, size_t(threads));
+            auto start = chrono::steady_clock::now();
+            timeThreads([&](int t) {
+                for (size_t i = 0; i < perThread[t].size(); i += batchSize) {
+                    size_t end = min(perThread[t].size(), i + batchSize);
+                    router.submit(vector<Operation>(perThread[t].begin() + i, perThread[t].begin() + end));
+                }
+            });
+            router.drain();
+            routedTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        }
+
+        double total = double(opsCount / threads * threads);
+        cout << threads << "\t " << total / globalTime / 1e6 << "\t      " << total / shardedTime / 1e6
+             << "\t\t" << total / routedTime / 1e6 << endl;
+    }
+
+    return 0;
+}
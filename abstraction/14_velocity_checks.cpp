@@ -0,0 +1,202 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+using namespace std;
+
+using Amount = int64_t; // whole cents, as in 3_fixed_point_money.cpp
+using Millis = uint64_t; // caller-supplied clock, milliseconds
+
+// Same idea as 6_status_codes_event_sink.cpp, plus the new rejection reason.
+enum class TxStatus : uint8_t {
+    Ok,
+    InvalidAmount,
+    InsufficientFunds,
+    VelocityLimited,
+};
+
+// Policy shared by many accounts. BankAccount rejects limits that are not
+// valid() when it is constructed.
+struct VelocityLimits {
+    uint32_t maxWithdrawals;  // at most this many withdrawals (1..16) ...
+    Millis countWindow;       // ... within this long
+    Amount maxAmount;         // at most this much withdrawn ...
+    Millis amountWindow;      // ... within this long
+
+    bool valid() const;
+};
+
+// Per-account state: 16 timestamps + 8 amount buckets, 264 bytes, no heap.
+//
+//  * Count limit: a ring of the last 16 withdrawal times. The withdrawal that
+//    would be the (maxWithdrawals + 1)-th in the window is rejected if the
+//    maxWithdrawals-th most recent one is still inside the window. Exact.
+//  * Amount limit: the window is split into 8 buckets; each bucket stores the
+//    sum withdrawn during its slice of time and the slice number it belongs
+//    to. Stale buckets are ignored, so the window slides with 1/8 granularity.
+//
+// Both checks are a handful of loads and compares -- well under a microsecond.
+class VelocityTracker {
+public:
+    static constexpr uint32_t TrackedWithdrawals = 16;
+    static constexpr uint32_t AmountBuckets = 8;
+
+private:
+    Millis recent[TrackedWithdrawals] = {};
+    uint32_t head = 0;  // next slot in 'recent'
+    uint32_t filled = 0;
+    Amount bucketSum[AmountBuckets] = {};
+    uint64_t bucketSlice[AmountBuckets] = {};
+
+public:
+    bool allows(Amount amount, Millis now, const VelocityLimits& limits) const {
+        if (limits.maxWithdrawals <= filled) {
+            Millis nth = recent[(head + TrackedWithdrawals - limits.maxWithdrawals) % TrackedWithdrawals];
+            if (now - nth < limits.countWindow) {
+                return false;
+            }
+        }
+        Millis width = max<Millis>(1, limits.amountWindow / AmountBuckets);
+        uint64_t slice = now / width;
+        Amount inWindow = amount;
+        for (uint32_t b = 0; b < AmountBuckets; ++b) {
+            inWindow += slice - bucketSlice[b] < AmountBuckets ? bucketSum[b] : 0;
+        }
+        return inWindow <= limits.maxAmount;
+    }
+
+    void record(Amount amount, Millis now, const VelocityLimits& limits) {
+        recent[head] = now;
+        head = (head + 1) % TrackedWithdrawals;
+        filled = min(filled + 1, TrackedWithdrawals);
+
+        Millis width = max<Millis>(1, limits.amountWindow / AmountBuckets);
+        uint64_t slice = now / width;
+        uint32_t b = slice % AmountBuckets;
+        if (bucketSlice[b] != slice) {
+            bucketSlice[b] = slice;
+            bucketSum[b] = 0;
+        }
+        bucketSum[b] += amount;
+    }
+};
+
+// The tracker only remembers 16 withdrawal times, so a larger count limit
+// could never trigger, and a limit of 0 would block every withdrawal only
+// once 16 had happened.
+inline bool VelocityLimits::valid() const {
+    return maxWithdrawals >= 1 && maxWithdrawals <= VelocityTracker::TrackedWithdrawals && maxAmount >= 0;
+}
+
+class BankAccount {
+private:
+    Amount balance;
+    const VelocityLimits* limits; // optional; nullptr disables the checks
+    VelocityTracker velocity;
+
+public:
+    BankAccount(Amount initialBalance, const VelocityLimits* velocityLimits = nullptr)
+        : balance(initialBalance >= 0 ? initialBalance : 0), limits(velocityLimits) {
+        if (limits && !limits->valid()) {
+            throw invalid_argument("BankAccount: velocity limits need 1..16 withdrawals and a non-negative amount");
+        }
+    }
+
+    TxStatus deposit(Amount amount) {
+        if (amount <= 0) {
+            return TxStatus::InvalidAmount;
+        }
+        balance += amount;
+        return TxStatus::Ok;
+    }
+
+    TxStatus withdraw(Amount amount, Millis now) {
+        if (amount <= 0) {
+            return TxStatus::InvalidAmount;
+        }
+        if (amount > balance) {
+            return TxStatus::InsufficientFunds;
+        }
+        if (limits) {
+            if (!velocity.allows(amount, now, *limits)) {
+                return TxStatus::VelocityLimited;
+            }
+            velocity.record(amount, now, *limits);
+        }
+        balance -= amount;
+        return TxStatus::Ok;
+    }
+
+    Amount getBalance() const {
+        return balance;
+    }
+};
+
+// Per-withdrawal latency over many accounts, so the tracker is not always hot
+// in L1. Returns {p50, p99} in nanoseconds.
+pair<int64_t, int64_t> measure(vector<BankAccount>& accounts, size_t operations) {
+    mt19937_64 rng(5);
+    vector<int64_t> samples(operations);
+    Millis now = 1'000'000;
+    for (size_t i = 0; i < operations; ++i) {
+        BankAccount& a = accounts[rng() % accounts.size()];
+        Amount amount = Amount(1 + rng() % 5'000);
+        now += rng() % 3;
+        auto start = chrono::steady_clock::now();
+        a.withdraw(amount, now);
+        auto stop = chrono::steady_clock::now();
+        samples[i] = chrono::duration_cast<chrono::nanoseconds>(stop - start).count();
+    }
+    sort(samples.begin(), samples.end());
+    return {samples[operations / 2], samples[operations * 99 / 100]};
+}
+
+const char* describe(TxStatus s) {
+    switch (s) {
+        case TxStatus::Ok: return "ok";
+        case TxStatus::InvalidAmount: return "invalid amount";
+        case TxStatus::InsufficientFunds: return "insufficient funds";
+        case TxStatus::VelocityLimited: return "velocity limit";
+    }
+    return "unknown";
+}
+
+int main(int argc, char* argv[]) {
+    // At most 3 withdrawals per minute and $500 per hour.
+    VelocityLimits limits{3, 60'000, 50'000, 3'600'000};
+    BankAccount myAccount(1'000'000, &limits);
+    Millis t = 0;
+    for (Amount amount : {10'000, 10'000, 10'000, 10'000}) {
+        cout << "t=" << t / 1000 << "s withdraw " << amount << ": " << describe(myAccount.withdraw(amount, t)) << endl;
+        t += 5'000;
+    }
+    t += 60'000;
+    cout << "t=" << t / 1000 << "s withdraw 30000: " << describe(myAccount.withdraw(30'000, t)) << endl;
+    cout << "t=" << t / 1000 << "s withdraw 5000:  " << describe(myAccount.withdraw(5'000, t)) << endl;
+    try {
+        VelocityLimits tooMany{20, 60'000, 50'000, 3'600'000};
+        BankAccount rejected(1'000, &tooMany);
+    } catch (const invalid_argument& e) {
+        cout << "Rejected policy: " << e.what() << endl;
+    }
+
+    // Usage: ./a.out [accounts] [operations]
+    size_t accountCount = argc > 1 ? stoull(argv[1]) : 1'000'000;
+    size_t operations = argc > 2 ? stoull(argv[2]) : 2'000'000;
+
+    vector<BankAccount> plain(accountCount, BankAccount(1'000'000'000));
+    vector<BankAccount> checked(accountCount, BankAccount(1'000'000'000, &limits));
+    auto [p50Plain, p99Plain] = measure(plain, operations);
+    auto [p50Checked, p99Checked] = measure(checked, operations);
+
+    cout << "\nwithdraw latency over " << accountCount << " accounts (includes ~20 ns clock overhead)" << endl;
+    cout << "  without velocity checks: p50 " << p50Plain << " ns, p99 " << p99Plain << " ns" << endl;
+    cout << "  with velocity checks:    p50 " << p50Checked << " ns, p99 " << p99Checked << " ns" << endl;
+    cout << "  sizeof(VelocityTracker): " << sizeof(VelocityTracker) << " bytes per account" << endl;
+
+    return 0;
+}
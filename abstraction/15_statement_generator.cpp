@@ -0,0 +1,275 @@
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <fcntl.h>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+using namespace std;
+
+using Amount = int64_t; // whole cents, as in 3_fixed_point_money.cpp
+
+struct Transaction {
+    int32_t day;   // days since 1970-01-01
+    Amount amount; // signed: deposits positive, withdrawals negative
+};
+
+// A month of history for many accounts in compressed-row form: the
+// transactions of account i are entries[offsets[i] .. offsets[i + 1]).
+// One flat array instead of one vector per account.
+struct TransactionHistory {
+    vector<Amount> openingBalances;
+    vector<uint64_t> offsets{0};
+    vector<Transaction> entries;
+
+    size_t accountCount() const { return openingBalances.size(); }
+};
+
+// Appends text to a large buffer and hands it to write(2) only when full,
+// so a statement costs a few memcpys, not a syscall per line. Call close()
+// to find out whether everything reached the file; the destructor closes
+// too, but has to swallow errors.
+class BufferedFileWriter {
+private:
+    int fd;
+    bool ownsFd;
+    bool closed = false;
+    vector<char> buffer;
+    size_t used = 0;
+    size_t written = 0;
+
+    void flush() {
+        size_t done = 0;
+        while (done < used) {
+            ssize_t n = ::write(fd, buffer.data() + done, used - done);
+            if (n < 0) {
+                throw runtime_error("BufferedFileWriter: write failed");
+            }
+            done += size_t(n);
+        }
+        written += used;
+        used = 0;
+    }
+
+public:
+    BufferedFileWriter(const string& path, size_t bufferBytes = 4 << 20) : ownsFd(true), buffer(bufferBytes) {
+        fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            throw runtime_error("BufferedFileWriter: cannot open " + path);
+        }
+    }
+
+    // Writes to an already-open descriptor (e.g. STDOUT_FILENO) without closing it.
+    BufferedFileWriter(int openFd, size_t bufferBytes) : fd(openFd), ownsFd(false), buffer(bufferBytes) {}
+
+    BufferedFileWriter(const BufferedFileWriter&) = delete;
+    BufferedFileWriter& operator=(const BufferedFileWriter&) = delete;
+
+    ~BufferedFileWriter() {
+        try {
+            close();
+        } catch (...) {
+            // Nowhere to report it from a destructor; callers that care call close().
+        }
+    }
+
+    // Writes out what is buffered and closes the descriptor if we own it.
+    // Throws if either fails. Further calls do nothing.
+    void close() {
+        if (closed) {
+            return;
+        }
+        closed = true;
+        try {
+            flush();
+        } catch (...) {
+            if (ownsFd) {
+                ::close(fd);
+            }
+            throw;
+        }
+        if (ownsFd && ::close(fd) != 0) {
+            throw runtime_error("BufferedFileWriter: close failed");
+        }
+    }
+
+    // Returns room for at least 'bytes' characters; commit() what was used.
+    // A request larger than the whole buffer grows it.
+    char* reserve(size_t bytes) {
+        if (buffer.size() - used < bytes) {
+            flush();
+            if (buffer.size() < bytes) {
+                buffer.resize(bytes);
+            }
+        }
+        return buffer.data() + used;
+    }
+    void commit(char* end) { used = size_t(end - buffer.data()); }
+
+    void append(const char* text, size_t n) {
+        char* p = reserve(n);
+        memcpy(p, text, n);
+        commit(p + n);
+    }
+
+    size_t bytesWritten() const { return written + used; }
+};
+
+// Formats cents as "-1234.05" with to_chars; never allocates.
+char* formatMoney(char* out, Amount cents) {
+    if (cents < 0) {
+        *out++ = '-';
+    }
+    uint64_t magnitude = cents < 0 ? uint64_t(0) - uint64_t(cents) : uint64_t(cents);
+    out = to_chars(out, out + 24, magnitude / 100).ptr;
+    uint64_t c = magnitude % 100;
+    *out++ = '.';
+    *out++ = char('0' + c / 10);
+    *out++ = char('0' + c % 10);
+    return out;
+}
+
+// Formats a day number as YYYY-MM-DD (H. Hinnant's civil_from_days).
+char* formatDate(char* out, int32_t days) {
+    int64_t z = int64_t(days) + 719468;
+    int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    int64_t doe = z - era * 146097;
+    int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int64_t mp = (5 * doy + 2) / 153;
+    int64_t d = doy - (153 * mp + 2) / 5 + 1;
+    int64_t m = mp < 10 ? mp + 3 : mp - 9;
+    int64_t y = yoe + era * 400 + (m <= 2);
+    out = to_chars(out, out + 8, y).ptr;
+    *out++ = '-';
+    *out++ = char('0' + m / 10);
+    *out++ = char('0' + m % 10);
+    *out++ = '-';
+    *out++ = char('0' + d / 10);
+    *out++ = char('0' + d % 10);
+    return out;
+}
+
+// Streams one account's statement into the writer.
+void writeStatement(BufferedFileWriter& out, const TransactionHistory& history, size_t account) {
+    constexpr size_t MaxLine = 96; // generous upper bound for every line below
+    Amount balance = history.openingBalances[account];
+
+    char* p = out.reserve(2 * MaxLine);
+    memcpy(p, "STATEMENT account ", 18);
+    p = to_chars(p + 18, p + 40, account).ptr;
+    memcpy(p, "\nopening balance ", 17);
+    p = formatMoney(p + 17, balance);
+    *p++ = '\n';
+    out.commit(p);
+
+    for (uint64_t i = history.offsets[account]; i < history.offsets[account + 1]; ++i) {
+        const Transaction& t = history.entries[i];
+        balance += t.amount;
+        p = out.reserve(MaxLine);
+        p = formatDate(p, t.day);
+        memcpy(p, t.amount >= 0 ? "  deposit     " : "  withdrawal  ", 14);
+        p = formatMoney(p + 14, t.amount >= 0 ? t.amount : -t.amount);
+        memcpy(p, "  balance ", 10);
+        p = formatMoney(p + 10, balance);
+        *p++ = '\n';
+        out.commit(p);
+    }
+
+    p = out.reserve(MaxLine);
+    memcpy(p, "closing balance ", 16);
+    p = formatMoney(p + 16, balance);
+    memcpy(p, "\n\n", 2);
+    out.commit(p + 2);
+}
+
+// Splits accounts into contiguous ranges, one per thread, each thread writing
+// its own part file. Returns the total number of bytes written; rethrows
+// the first I/O error any thread hit.
+size_t generateStatements(const TransactionHistory& history, const string& prefix, unsigned threads) {
+    vector<thread> pool;
+    vector<size_t> bytes(threads, 0);
+    vector<exception_ptr> errors(threads);
+    size_t n = history.accountCount();
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            try {
+                BufferedFileWriter out(prefix + "_part" + to_string(t) + ".txt");
+                for (size_t a = n * t / threads; a < n * (t + 1) / threads; ++a) {
+                    writeStatement(out, history, a);
+                }
+                out.close();
+                bytes[t] = out.bytesWritten();
+            } catch (...) {
+                errors[t] = current_exception();
+            }
+        });
+    }
+    for (auto& th : pool) {
+        th.join();
+    }
+    for (const exception_ptr& e : errors) {
+        if (e) {
+            rethrow_exception(e);
+        }
+    }
+    size_t total = 0;
+    for (size_t b : bytes) {
+        total += b;
+    }
+    return total;
+}
+
+TransactionHistory makeHistory(size_t accounts, int perAccount) {
+    TransactionHistory h;
+    mt19937_64 rng(31);
+    const int32_t firstOfMonth = 20'362; // 2025-10-01
+    h.openingBalances.reserve(accounts);
+    h.entries.reserve(accounts * size_t(perAccount));
+    for (size_t a = 0; a < accounts; ++a) {
+        h.openingBalances.push_back(Amount(rng() % 1'000'000));
+        int count = int(rng() % (2 * perAccount + 1));
+        for (int i = 0; i < count; ++i) {
+            Amount amount = Amount(rng() % 20'000) - 8'000;
+            h.entries.push_back(Transaction{firstOfMonth + int32_t(i * 30 / max(count, 1)), amount});
+        }
+        h.offsets.push_back(h.entries.size());
+    }
+    return h;
+}
+
+int main(int argc, char* argv[]) {
+    // Usage: ./a.out [accounts] [avgTransactionsPerAccount] [threads] [outputPrefix]
+    size_t accounts = argc > 1 ? stoull(argv[1]) : 1'000'000;
+    int perAccount = argc > 2 ? stoi(argv[2]) : 20;
+    unsigned threads = argc > 3 ? unsigned(stoul(argv[3])) : max(1u, thread::hardware_concurrency());
+    string prefix = argc > 4 ? argv[4] : "/tmp/statements";
+
+    TransactionHistory history = makeHistory(accounts, perAccount);
+
+    {
+        cout.flush();
+        BufferedFileWriter sample(STDOUT_FILENO, 64); // smaller than a statement header; reserve() grows it
+        writeStatement(sample, makeHistory(1, 2), 0);
+        sample.close();
+    }
+
+    auto start = chrono::steady_clock::now();
+    size_t bytes = generateStatements(history, prefix, threads);
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    cout << accounts << " statements (" << history.entries.size() << " transactions) with " << threads
+         << " threads: " << double(accounts) / elapsed.count() << " statements/s, "
+         << double(bytes) / 1e6 / elapsed.count() << " MB/s" << endl;
+
+    for (unsigned t = 0; t < threads; ++t) {
+        ::unlink((prefix + "_part" + to_string(t) + ".txt").c_str());
+    }
+    return 0;
+}
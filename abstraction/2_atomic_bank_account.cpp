@@ -0,0 +1,174 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// Same interface idea as BankAccount in 1_abstraction.cpp, but safe to share
+// between threads. The balance is kept as whole cents in an atomic integer,
+// so no mutex is needed: deposit is a single fetch_add and withdraw is a
+// compare-and-swap loop that re-checks "amount <= balance" on every attempt.
+class ConcurrentBankAccount {
+private:
+    atomic<int64_t> balanceCents; // hidden, and now also thread-safe
+
+public:
+    explicit ConcurrentBankAccount(int64_t initialCents = 0)
+        : balanceCents(initialCents >= 0 ? initialCents : 0) {}
+
+    bool deposit(int64_t amountCents) {
+        if (amountCents <= 0) {
+            return false;
+        }
+        balanceCents.fetch_add(amountCents, memory_order_relaxed);
+        return true;
+    }
+
+    bool withdraw(int64_t amountCents) {
+        if (amountCents <= 0) {
+            return false;
+        }
+        int64_t current = balanceCents.load(memory_order_relaxed);
+        // If another thread changes the balance between our load and our
+        // store, compare_exchange_weak fails and reloads 'current' for us.
+        while (amountCents <= current) {
+            if (balanceCents.compare_exchange_weak(current, current - amountCents,
+                                                   memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false; // insufficient funds
+    }
+
+    int64_t getBalance() const {
+        return balanceCents.load(memory_order_relaxed);
+    }
+};
+
+// The "obvious" thread-safe version, used as the baseline in the benchmark.
+class MutexBankAccount {
+private:
+    mutable mutex lock;
+    int64_t balanceCents;
+
+public:
+    explicit MutexBankAccount(int64_t initialCents = 0)
+        : balanceCents(initialCents >= 0 ? initialCents : 0) {}
+
+    bool deposit(int64_t amountCents) {
+        if (amountCents <= 0) {
+            return false;
+        }
+        lock_guard<mutex> guard(lock);
+        balanceCents += amountCents;
+        return true;
+    }
+
+    bool withdraw(int64_t amountCents) {
+        if (amountCents <= 0) {
+            return false;
+        }
+        lock_guard<mutex> guard(lock);
+        if (amountCents > balanceCents) {
+            return false;
+        }
+        balanceCents -= amountCents;
+        return true;
+    }
+
+    int64_t getBalance() const {
+        lock_guard<mutex> guard(lock);
+        return balanceCents;
+    }
+};
+
+// Keeps each account on its own cache line so the "many accounts" run does
+// not measure false sharing instead of the account itself.
+template <typename Account>
+struct alignas(64) PaddedAccount {
+    Account account{1'000'000};
+};
+
+// Every thread alternates deposit(3) / withdraw(2) on its target account,
+// rounding an odd opsPerThread up to whole pairs. Returns operations per
+// second.
+template <typename Account>
+double hammer(int threadCount, bool sharedAccount, int opsPerThread) {
+    vector<PaddedAccount<Account>> accounts(sharedAccount ? 1 : threadCount);
+    vector<thread> workers;
+    atomic<bool> go{false};
+    int pairs = (opsPerThread + 1) / 2;
+
+    for (int t = 0; t < threadCount; ++t) {
+        Account& target = accounts[sharedAccount ? 0 : t].account;
+        workers.emplace_back([&target, &go, pairs] {
+            while (!go.load(memory_order_acquire)) {
+            }
+            for (int i = 0; i < pairs; ++i) {
+                target.deposit(3);
+                target.withdraw(2);
+            }
+        });
+    }
+
+    auto start = chrono::steady_clock::now();
+    go.store(true, memory_order_release);
+    for (auto& w : workers) {
+        w.join();
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    // Every pair of operations adds exactly one cent, so the final total tells
+    // us whether any update was lost.
+    int64_t expected = int64_t(accounts.size()) * 1'000'000 + int64_t(threadCount) * pairs;
+    int64_t actual = 0;
+    for (auto& a : accounts) {
+        actual += a.account.getBalance();
+    }
+    if (actual != expected) {
+        cout << "  !! lost updates: expected " << expected << ", got " << actual << endl;
+    }
+    return double(threadCount) * 2 * pairs / elapsed.count();
+}
+
+// 1, 2, 4, ... below maxThreads, then maxThreads itself, so the top count
+// is measured even when it is not a power of two.
+vector<int> threadCounts(int maxThreads) {
+    vector<int> counts;
+    for (int threads = 1; threads < maxThreads; threads *= 2) {
+        counts.push_back(threads);
+    }
+    counts.push_back(max(maxThreads, 1));
+    return counts;
+}
+
+int main(int argc, char* argv[]) {
+    // Correctness first: the "amount <= balance" rule still holds.
+    ConcurrentBankAccount myAccount(100'000); // $1000.00
+    myAccount.deposit(50'000);
+    cout << "Balance after deposit: " << myAccount.getBalance() << " cents" << endl;
+    cout << "Withdraw $2000.00: " << (myAccount.withdraw(200'000) ? "ok" : "rejected") << endl;
+    cout << "Withdraw $200.00:  " << (myAccount.withdraw(20'000) ? "ok" : "rejected") << endl;
+    cout << "Balance after withdrawal: " << myAccount.getBalance() << " cents" << endl;
+
+    // Usage: ./a.out [maxThreads] [opsPerThread]
+    int maxThreads = argc > 1 ? stoi(argv[1]) : int(max(2u, thread::hardware_concurrency()));
+    int opsPerThread = argc > 2 ? stoi(argv[2]) : 2'000'000;
+
+    cout << "\nthreads  layout     atomic Mops/s  mutex Mops/s" << endl;
+    for (int threads : threadCounts(maxThreads)) {
+        for (bool shared : {true, false}) {
+            double atomicRate = hammer<ConcurrentBankAccount>(threads, shared, opsPerThread);
+            double mutexRate = hammer<MutexBankAccount>(threads, shared, opsPerThread);
+            cout << threads << "\t " << (shared ? "one acct " : "per-thread") << "\t"
+                 << atomicRate / 1e6 << "\t\t" << mutexRate / 1e6 << endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,270 @@
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+using namespace std;
+
+// A decimal amount stored as an integer count of 10^-Decimals units.
+// FixedPoint<2> is "whole cents": 12.34 is stored as 1234. Addition and
+// subtraction are exact integer operations, so a million deposits of 0.01
+// add up to exactly 10000.00 -- something a double cannot promise.
+template <int Decimals>
+class FixedPoint {
+    static_assert(Decimals >= 0 && Decimals <= 9, "scale must fit comfortably in int64");
+
+private:
+    int64_t units;
+
+    explicit constexpr FixedPoint(int64_t rawUnits) : units(rawUnits) {}
+
+public:
+    static constexpr int64_t scale() {
+        int64_t s = 1;
+        for (int i = 0; i < Decimals; ++i) {
+            s *= 10;
+        }
+        return s;
+    }
+
+    constexpr FixedPoint() : units(0) {}
+
+    static constexpr FixedPoint fromUnits(int64_t rawUnits) { return FixedPoint(rawUnits); }
+
+    // Rounding rule: half away from zero, applied once at the boundary where a
+    // double enters the system. 0.005 -> 0.01, -0.005 -> -0.01.
+    static FixedPoint fromDouble(double value) {
+        double scaled = round(value * double(scale())); // round() is half-away-from-zero
+        if (!(scaled >= -9.2e18 && scaled <= 9.2e18)) { // also rejects NaN
+            throw overflow_error("FixedPoint::fromDouble: value out of range");
+        }
+        return FixedPoint(int64_t(scaled));
+    }
+
+    // Exact parse of text such as "-12.345". Digits beyond the scale are
+    // rounded half away from zero, the same rule as fromDouble.
+    static FixedPoint parse(const string& text) {
+        size_t pos = 0;
+        bool negative = false;
+        if (pos < text.size() && (text[pos] == '-' || text[pos] == '+')) {
+            negative = text[pos] == '-';
+            ++pos;
+        }
+        int64_t result = 0;
+        int fractionDigits = -1; // -1 while still in the integer part
+        bool roundUp = false;
+        bool sawDigit = false;
+        for (; pos < text.size(); ++pos) {
+            char c = text[pos];
+            if (c == '.' && fractionDigits < 0) {
+                fractionDigits = 0;
+                continue;
+            }
+            if (c < '0' || c > '9') {
+                throw invalid_argument("FixedPoint::parse: bad character in '" + text + "'");
+            }
+            sawDigit = true;
+            if (fractionDigits >= Decimals) {
+                if (fractionDigits == Decimals) {
+                    roundUp = c >= '5';
+                }
+                ++fractionDigits;
+                continue;
+            }
+            if (__builtin_mul_overflow(result, 10, &result) ||
+                __builtin_add_overflow(result, c - '0', &result)) {
+                throw overflow_error("FixedPoint::parse: '" + text + "' out of range");
+            }
+            if (fractionDigits >= 0) {
+                ++fractionDigits;
+            }
+        }
+        if (!sawDigit) {
+            throw invalid_argument("FixedPoint::parse: no digits in '" + text + "'");
+        }
+        for (int d = max(fractionDigits, 0); d < Decimals; ++d) {
+            if (__builtin_mul_overflow(result, 10, &result)) {
+                throw overflow_error("FixedPoint::parse: '" + text + "' out of range");
+            }
+        }
+        if (roundUp && __builtin_add_overflow(result, 1, &result)) {
+            throw overflow_error("FixedPoint::parse: '" + text + "' out of range");
+        }
+        return FixedPoint(negative ? -result : result);
+    }
+
+    constexpr int64_t rawUnits() const { return units; }
+    double toDouble() const { return double(units) / double(scale()); }
+
+    string toString() const {
+        uint64_t magnitude = units < 0 ? uint64_t(0) - uint64_t(units) : uint64_t(units);
+        string whole = to_string(magnitude / uint64_t(scale()));
+        string result = (units < 0 ? "-" : "") + whole;
+        if (Decimals > 0) {
+            string fraction = to_string(magnitude % uint64_t(scale()));
+            result += "." + string(Decimals - fraction.size(), '0') + fraction;
+        }
+        return result;
+    }
+
+    // Checked arithmetic: overflow is an error, never a silent wrap.
+    FixedPoint operator+(FixedPoint other) const {
+        int64_t out;
+        if (__builtin_add_overflow(units, other.units, &out)) {
+            throw overflow_error("FixedPoint: addition overflow");
+        }
+        return FixedPoint(out);
+    }
+
+    FixedPoint operator-(FixedPoint other) const {
+        int64_t out;
+        if (__builtin_sub_overflow(units, other.units, &out)) {
+            throw overflow_error("FixedPoint: subtraction overflow");
+        }
+        return FixedPoint(out);
+    }
+
+    FixedPoint operator*(int64_t count) const {
+        int64_t out;
+        if (__builtin_mul_overflow(units, count, &out)) {
+            throw overflow_error("FixedPoint: multiplication overflow");
+        }
+        return FixedPoint(out);
+    }
+
+    FixedPoint& operator+=(FixedPoint other) { return *this = *this + other; }
+    FixedPoint& operator-=(FixedPoint other) { return *this = *this - other; }
+
+    friend constexpr bool operator==(FixedPoint a, FixedPoint b) { return a.units == b.units; }
+    friend constexpr bool operator<(FixedPoint a, FixedPoint b) { return a.units < b.units; }
+    friend constexpr bool operator<=(FixedPoint a, FixedPoint b) { return a.units <= b.units; }
+    friend constexpr bool operator>(FixedPoint a, FixedPoint b) { return a.units > b.units; }
+
+    friend ostream& operator<<(ostream& out, FixedPoint value) { return out << value.toString(); }
+};
+
+using Money = FixedPoint<2>;
+
+// BankAccount from 1_abstraction.cpp with Money instead of double. The rules
+// are unchanged; only the representation of the hidden balance differs.
+class BankAccount {
+private:
+    Money balance;
+
+public:
+    BankAccount(Money initialBalance) {
+        if (Money() <= initialBalance) {
+            balance = initialBalance;
+        }
+    }
+
+    // Returns false for non-positive amounts, and throws overflow_error if the
+    // balance would exceed what an int64 count of cents can hold.
+    bool deposit(Money amount) {
+        if (amount <= Money()) {
+            return false;
+        }
+        balance += amount;
+        return true;
+    }
+
+    bool withdraw(Money amount) {
+        if (Money() < amount && amount <= balance) {
+            balance -= amount; // cannot overflow: 0 < amount <= balance
+            return true;
+        }
+        return false;
+    }
+
+    Money getBalance() const {
+        return balance;
+    }
+};
+
+// The same bulk loop three ways: on doubles, on raw cents, and on Money. The
+// raw loop shows what integer cents cost without checks; the Money loop adds
+// the overflow check on every operator+=.
+double applyAllDouble(double balance, const vector<double>& amounts) {
+    for (double a : amounts) {
+        balance += a;
+    }
+    return balance;
+}
+
+int64_t applyAllCents(int64_t balance, const vector<int64_t>& amounts) {
+    for (int64_t a : amounts) {
+        balance += a;
+    }
+    return balance;
+}
+
+Money applyAllMoney(Money balance, const vector<Money>& amounts) {
+    for (Money a : amounts) {
+        balance += a;
+    }
+    return balance;
+}
+
+int main(int argc, char* argv[]) {
+    BankAccount myAccount(Money::parse("1000.00"));
+    myAccount.deposit(Money::parse("500.005")); // rounds to 500.01
+    cout << "Balance after deposit: $" << myAccount.getBalance() << endl;
+    myAccount.withdraw(Money::fromDouble(200.0));
+    cout << "Balance after withdrawal: $" << myAccount.getBalance() << endl;
+
+    try {
+        BankAccount rich(Money::fromUnits(INT64_MAX - 10));
+        rich.deposit(Money::parse("1.00"));
+    } catch (const overflow_error& e) {
+        cout << "Caught: " << e.what() << endl;
+    }
+
+    // Usage: ./a.out [transactions]
+    size_t n = argc > 1 ? stoull(argv[1]) : 20'000'000;
+
+    // Drift: n deposits of one cent, each through BankAccount::deposit.
+    double driftD = 0.0;
+    BankAccount driftAccount(Money{});
+    const Money oneCent = Money::fromUnits(1);
+    for (size_t i = 0; i < n; ++i) {
+        driftD += 0.01;
+        driftAccount.deposit(oneCent);
+    }
+    cout << "\n" << n << " deposits of $0.01" << endl;
+    cout.precision(17);
+    cout << "  double:      " << driftD << endl;
+    cout << "  fixed-point: " << driftAccount.getBalance() << endl;
+
+    // Throughput: random signed transactions between -$500 and +$500.
+    mt19937_64 rng(42);
+    uniform_int_distribution<int64_t> dist(-50'000, 50'000);
+    vector<int64_t> cents(n);
+    vector<double> dollars(n);
+    vector<Money> money(n);
+    for (size_t i = 0; i < n; ++i) {
+        cents[i] = dist(rng);
+        dollars[i] = double(cents[i]) / 100.0;
+        money[i] = Money::fromUnits(cents[i]);
+    }
+
+    auto t0 = chrono::steady_clock::now();
+    double totalD = applyAllDouble(0.0, dollars);
+    auto t1 = chrono::steady_clock::now();
+    int64_t totalC = applyAllCents(0, cents);
+    auto t2 = chrono::steady_clock::now();
+    Money totalM = applyAllMoney(Money{}, money);
+    auto t3 = chrono::steady_clock::now();
+
+    chrono::duration<double> dT = t1 - t0, cT = t2 - t1, mT = t3 - t2;
+    cout << "\nBulk apply of " << n << " transactions" << endl;
+    cout << "  double:      " << totalD;
+    cout.precision(6);
+    cout << "  in " << dT.count() * 1e3 << " ms" << endl;
+    cout << "  raw cents:   " << Money::fromUnits(totalC) << "  in " << cT.count() * 1e3 << " ms" << endl;
+    cout << "  Money:       " << totalM << "  in " << mT.count() * 1e3 << " ms (overflow-checked)" << endl;
+
+    return 0;
+}
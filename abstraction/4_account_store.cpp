@@ -0,0 +1,180 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Holds many accounts as columns instead of as an array of BankAccount
+// objects. Account ids are dense (0, 1, 2, ...) and double as the row index,
+// so "the balance of account 7" is simply balances[7]. Each aggregate query
+// then walks one tightly packed int64 column, which the compiler can
+// auto-vectorise.
+//
+// Amounts are whole cents, as in 3_fixed_point_money.cpp.
+class AccountStore {
+private:
+    vector<int64_t> balances;        // current balance
+    vector<int64_t> depositedTotals; // lifetime sum of successful deposits
+
+public:
+    using AccountId = uint32_t;
+
+private:
+    void checkRange(AccountId first, size_t count) const {
+        if (first > balances.size() || count > balances.size() - first) {
+            throw out_of_range("AccountStore: id range past the last account");
+        }
+    }
+
+public:
+    AccountId open(int64_t initialCents) {
+        balances.push_back(initialCents >= 0 ? initialCents : 0);
+        depositedTotals.push_back(0);
+        return AccountId(balances.size() - 1);
+    }
+
+    // Opens 'count' accounts at once; returns the id of the first one.
+    AccountId openMany(size_t count, int64_t initialCents) {
+        AccountId first = AccountId(balances.size());
+        balances.resize(balances.size() + count, initialCents >= 0 ? initialCents : 0);
+        depositedTotals.resize(balances.size(), 0);
+        return first;
+    }
+
+    size_t size() const { return balances.size(); }
+
+    int64_t getBalance(AccountId id) const { return balances[id]; }
+
+    // Single-account operations keep BankAccount's rules.
+    bool deposit(AccountId id, int64_t amountCents) {
+        if (amountCents <= 0) {
+            return false;
+        }
+        balances[id] += amountCents;
+        depositedTotals[id] += amountCents;
+        return true;
+    }
+
+    bool withdraw(AccountId id, int64_t amountCents) {
+        if (amountCents > 0 && amountCents <= balances[id]) {
+            balances[id] -= amountCents;
+            return true;
+        }
+        return false;
+    }
+
+    // Bulk operations over the contiguous id range [first, first + count).
+    // amounts[i] applies to account first + i. Invalid entries are skipped
+    // with a select instead of a branch so the loops stay vectorisable; a
+    // range that runs past the last account throws out_of_range.
+    void depositRange(AccountId first, span<const int64_t> amounts) {
+        checkRange(first, amounts.size());
+        int64_t* bal = balances.data() + first;
+        int64_t* dep = depositedTotals.data() + first;
+        for (size_t i = 0; i < amounts.size(); ++i) {
+            int64_t a = amounts[i] > 0 ? amounts[i] : 0;
+            bal[i] += a;
+            dep[i] += a;
+        }
+    }
+
+    // Returns how many withdrawals were applied.
+    size_t withdrawRange(AccountId first, span<const int64_t> amounts) {
+        checkRange(first, amounts.size());
+        int64_t* bal = balances.data() + first;
+        size_t applied = 0;
+        for (size_t i = 0; i < amounts.size(); ++i) {
+            bool ok = amounts[i] > 0 && amounts[i] <= bal[i];
+            bal[i] -= ok ? amounts[i] : 0;
+            applied += ok;
+        }
+        return applied;
+    }
+
+    // Aggregate queries.
+    int64_t totalBalance() const {
+        return accumulate(balances.begin(), balances.end(), int64_t(0));
+    }
+
+    int64_t totalDeposits() const {
+        return accumulate(depositedTotals.begin(), depositedTotals.end(), int64_t(0));
+    }
+
+    size_t countNegative() const {
+        size_t n = 0;
+        for (int64_t b : balances) {
+            n += b < 0;
+        }
+        return n;
+    }
+
+    // Exposes the column for callers that run their own kernels over it.
+    span<const int64_t> balanceColumn() const { return balances; }
+};
+
+// The array-of-objects layout we are replacing: every field of an account is
+// dragged through the cache even when a query reads only the balance.
+struct AccountRecord {
+    int64_t balance;
+    int64_t depositedTotal;
+    string owner;
+};
+
+int main(int argc, char* argv[]) {
+    AccountStore store;
+    AccountStore::AccountId alice = store.open(100'000);
+    AccountStore::AccountId bob = store.open(5'000);
+    store.deposit(alice, 50'000);
+    store.withdraw(bob, 10'000); // rejected: insufficient funds
+    cout << "Alice: " << store.getBalance(alice) << " cents, Bob: " << store.getBalance(bob) << " cents" << endl;
+    try {
+        int64_t three[] = {100, 200, 300};
+        store.depositRange(bob, three); // only two accounts exist
+    } catch (const out_of_range& e) {
+        cout << "Rejected bulk deposit: " << e.what() << endl;
+    }
+
+    // Usage: ./a.out [accounts]
+    size_t n = argc > 1 ? stoull(argv[1]) : 10'000'000;
+    AccountStore::AccountId first = store.openMany(n, 10'000);
+
+    vector<int64_t> amounts(n);
+    for (size_t i = 0; i < n; ++i) {
+        amounts[i] = int64_t(i % 20'000); // some exceed the balance, some are zero
+    }
+
+    auto t0 = chrono::steady_clock::now();
+    store.depositRange(first, amounts);
+    size_t applied = store.withdrawRange(first, amounts);
+    auto t1 = chrono::steady_clock::now();
+    int64_t total = store.totalBalance();
+    int64_t deposits = store.totalDeposits();
+    size_t negative = store.countNegative();
+    auto t2 = chrono::steady_clock::now();
+
+    chrono::duration<double> bulk = t1 - t0, query = t2 - t1;
+    cout << "\nColumnar store, " << n << " accounts" << endl;
+    cout << "  bulk deposit+withdraw: " << bulk.count() * 1e3 << " ms (" << applied << " withdrawals applied)" << endl;
+    cout << "  aggregates:            " << query.count() * 1e3 << " ms (total " << total << ", deposits " << deposits
+         << ", negative " << negative << ")" << endl;
+
+    vector<AccountRecord> records(n, AccountRecord{10'000, 0, "account holder"});
+    auto t3 = chrono::steady_clock::now();
+    int64_t aosTotal = 0, aosDeposits = 0;
+    size_t aosNegative = 0;
+    for (const AccountRecord& r : records) {
+        aosTotal += r.balance;
+        aosDeposits += r.depositedTotal;
+        aosNegative += r.balance < 0;
+    }
+    auto t4 = chrono::steady_clock::now();
+    chrono::duration<double> aos = t4 - t3;
+    cout << "Array of objects, same aggregates: " << aos.count() * 1e3 << " ms (total " << aosTotal << ", deposits "
+         << aosDeposits << ", negative " << aosNegative << ")" << endl;
+
+    return 0;
+}
@@ -0,0 +1,145 @@
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+using namespace std;
+
+using Amount = int64_t; // whole cents, as in 3_fixed_point_money.cpp
+
+// One bit per operation of a batch: bit i is set when operation i succeeded.
+// 1M results fit in 125 KB instead of 1M bools or 1M printed lines.
+class BatchResult {
+private:
+    vector<uint64_t> words;
+    size_t count;
+
+public:
+    explicit BatchResult(size_t operations) : words((operations + 63) / 64, 0), count(operations) {}
+
+    void set(size_t i, bool ok) { words[i / 64] |= uint64_t(ok) << (i % 64); }
+    bool succeeded(size_t i) const { return (words[i / 64] >> (i % 64)) & 1; }
+    size_t size() const { return count; }
+
+    size_t successCount() const {
+        size_t n = 0;
+        for (uint64_t w : words) {
+            n += popcount(w);
+        }
+        return n;
+    }
+
+    span<const uint64_t> bits() const { return words; }
+};
+
+class BankAccount {
+private:
+    Amount balance;
+    ostream& log; // where the per-call methods report, like 1_abstraction.cpp
+
+public:
+    BankAccount(Amount initialBalance, ostream& out = cout)
+        : balance(initialBalance >= 0 ? initialBalance : 0), log(out) {}
+
+    // Per-call interface, unchanged from 1_abstraction.cpp.
+    void deposit(Amount amount) {
+        if (amount > 0) {
+            balance += amount;
+            log << "Deposit successful." << endl;
+        } else {
+            log << "Deposit amount must be positive." << endl;
+        }
+    }
+
+    bool withdraw(Amount amount) {
+        if (amount > 0 && amount <= balance) {
+            balance -= amount;
+            log << "Withdrawal successful." << endl;
+            return true;
+        }
+        log << "Withdrawal failed. Invalid amount or insufficient funds." << endl;
+        return false;
+    }
+
+    // Batch interface: applies the amounts in order with exactly the same
+    // rules as the per-call methods, but performs no I/O. The caller decides
+    // what, if anything, to report from the returned bitmask.
+    BatchResult depositBatch(span<const Amount> amounts) {
+        BatchResult result(amounts.size());
+        Amount b = balance;
+        for (size_t i = 0; i < amounts.size(); ++i) {
+            bool ok = amounts[i] > 0;
+            b += ok ? amounts[i] : 0;
+            result.set(i, ok);
+        }
+        balance = b;
+        return result;
+    }
+
+    BatchResult withdrawBatch(span<const Amount> amounts) {
+        BatchResult result(amounts.size());
+        Amount b = balance;
+        // Each withdrawal depends on the balance left by the previous one, so
+        // this loop is inherently sequential; the select keeps it branch-free.
+        for (size_t i = 0; i < amounts.size(); ++i) {
+            bool ok = amounts[i] > 0 && amounts[i] <= b;
+            b -= ok ? amounts[i] : 0;
+            result.set(i, ok);
+        }
+        balance = b;
+        return result;
+    }
+
+    Amount getBalance() const {
+        return balance;
+    }
+};
+
+int main(int argc, char* argv[]) {
+    BankAccount myAccount(100'000);
+    myAccount.deposit(50'000);
+    vector<Amount> batch = {20'000, 500'000, -5, 30'000};
+    BatchResult r = myAccount.withdrawBatch(batch);
+    for (size_t i = 0; i < r.size(); ++i) {
+        cout << "Withdraw " << batch[i] << ": " << (r.succeeded(i) ? "ok" : "rejected") << endl;
+    }
+    cout << "Balance: " << myAccount.getBalance() << " cents" << endl;
+
+    // Usage: ./a.out [operations]
+    size_t n = argc > 1 ? stoull(argv[1]) : 1'000'000;
+    mt19937_64 rng(7);
+    uniform_int_distribution<Amount> dist(-100, 10'000);
+    vector<Amount> amounts(n);
+    for (Amount& a : amounts) {
+        a = dist(rng);
+    }
+
+    // Per-call loop, logging to /dev/null so we measure formatting and
+    // flushing rather than the terminal.
+    ofstream sink("/dev/null");
+    BankAccount perCall(Amount(n) * 2'500, sink);
+    auto t0 = chrono::steady_clock::now();
+    size_t perCallOk = 0;
+    for (Amount a : amounts) {
+        perCallOk += perCall.withdraw(a);
+    }
+    auto t1 = chrono::steady_clock::now();
+
+    BankAccount batched(Amount(n) * 2'500, sink);
+    auto t2 = chrono::steady_clock::now();
+    BatchResult result = batched.withdrawBatch(amounts);
+    auto t3 = chrono::steady_clock::now();
+
+    chrono::duration<double> perCallTime = t1 - t0, batchTime = t3 - t2;
+    cout << "\n" << n << " withdrawals" << endl;
+    cout << "  per-call loop:  " << perCallTime.count() * 1e3 << " ms, " << perCallOk << " ok, balance "
+         << perCall.getBalance() << endl;
+    cout << "  withdrawBatch:  " << batchTime.count() * 1e3 << " ms, " << result.successCount() << " ok, balance "
+         << batched.getBalance() << endl;
+
+    return 0;
+}
@@ -0,0 +1,237 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+using Amount = int64_t; // whole cents, as in 3_fixed_point_money.cpp
+
+// What deposit()/withdraw() now return instead of printing.
+enum class TxStatus : uint8_t {
+    Ok,
+    InvalidAmount,
+    InsufficientFunds,
+};
+
+const char* describe(TxStatus status) {
+    switch (status) {
+        case TxStatus::Ok: return "successful";
+        case TxStatus::InvalidAmount: return "failed: amount must be positive";
+        case TxStatus::InsufficientFunds: return "failed: insufficient funds";
+    }
+    return "unknown";
+}
+
+struct AccountEvent {
+    enum Kind : uint8_t { Deposit, Withdrawal } kind;
+    TxStatus status;
+    Amount amount;
+    Amount balanceAfter;
+};
+
+// Interface for anyone who wants to hear about account activity. The account
+// only knows this abstract contract, not whether events are printed, queued,
+// or dropped.
+class EventSink {
+public:
+    // Called on the transaction path, so implementations must be cheap and
+    // must not block.
+    virtual void publish(const AccountEvent& event) noexcept = 0;
+    virtual ~EventSink() {}
+};
+
+// Single-producer / single-consumer lock-free ring buffer. The account thread
+// pushes events; a background thread pops them, formats them and writes them
+// out. If the consumer falls behind, new events are dropped and counted
+// rather than stalling the producer.
+class RingBufferSink : public EventSink {
+private:
+    vector<AccountEvent> slots;
+    size_t mask;
+    alignas(64) atomic<size_t> head{0}; // next slot to write (producer)
+    alignas(64) atomic<size_t> tail{0}; // next slot to read (consumer)
+    alignas(64) atomic<size_t> dropped{0};
+    atomic<bool> running{true};
+    ostream& out;
+    thread drainer;
+
+    void drain() {
+        for (;;) {
+            size_t t = tail.load(memory_order_relaxed);
+            size_t h = head.load(memory_order_acquire);
+            if (t == h) {
+                if (!running.load(memory_order_acquire)) {
+                    // Events published before 'running' was cleared may have
+                    // arrived after the load of head above; look once more.
+                    h = head.load(memory_order_acquire);
+                    if (t == h) {
+                        break;
+                    }
+                } else {
+                    this_thread::yield();
+                    continue;
+                }
+            }
+            for (; t != h; ++t) {
+                const AccountEvent& e = slots[t & mask];
+                out << (e.kind == AccountEvent::Deposit ? "Deposit " : "Withdrawal ") << describe(e.status)
+                    << " (amount " << e.amount << ", balance " << e.balanceAfter << ")\n";
+            }
+            tail.store(t, memory_order_release);
+        }
+        out.flush();
+    }
+
+public:
+    // capacity is rounded up to a power of two.
+    RingBufferSink(ostream& destination, size_t capacity = 1 << 16)
+        : slots(bit_ceil(capacity)), mask(slots.size() - 1), out(destination) {
+        drainer = thread(&RingBufferSink::drain, this);
+    }
+
+    void publish(const AccountEvent& event) noexcept override {
+        size_t h = head.load(memory_order_relaxed);
+        if (h - tail.load(memory_order_acquire) == slots.size()) {
+            dropped.fetch_add(1, memory_order_relaxed);
+            return;
+        }
+        slots[h & mask] = event;
+        head.store(h + 1, memory_order_release);
+    }
+
+    size_t droppedCount() const { return dropped.load(); }
+
+    // Stops the background thread after it has written everything queued.
+    ~RingBufferSink() override {
+        running.store(false, memory_order_release);
+        drainer.join();
+    }
+};
+
+class BankAccount {
+private:
+    Amount balance;
+    EventSink* sink; // optional; nullptr means nobody is listening
+
+    void notify(AccountEvent::Kind kind, TxStatus status, Amount amount) {
+        if (sink) {
+            sink->publish(AccountEvent{kind, status, amount, balance});
+        }
+    }
+
+public:
+    BankAccount(Amount initialBalance, EventSink* eventSink = nullptr)
+        : balance(initialBalance >= 0 ? initialBalance : 0), sink(eventSink) {}
+
+    TxStatus deposit(Amount amount) {
+        TxStatus status = amount > 0 ? TxStatus::Ok : TxStatus::InvalidAmount;
+        if (status == TxStatus::Ok) {
+            balance += amount;
+        }
+        notify(AccountEvent::Deposit, status, amount);
+        return status;
+    }
+
+    TxStatus withdraw(Amount amount) {
+        TxStatus status = amount <= 0        ? TxStatus::InvalidAmount
+                          : amount > balance ? TxStatus::InsufficientFunds
+                                             : TxStatus::Ok;
+        if (status == TxStatus::Ok) {
+            balance -= amount;
+        }
+        notify(AccountEvent::Withdrawal, status, amount);
+        return status;
+    }
+
+    Amount getBalance() const {
+        return balance;
+    }
+};
+
+// The original behaviour from 1_abstraction.cpp, kept as the "before" case.
+class LoggingBankAccount {
+private:
+    Amount balance;
+    ostream& log;
+
+public:
+    LoggingBankAccount(Amount initialBalance, ostream& out) : balance(initialBalance), log(out) {}
+
+    void deposit(Amount amount) {
+        if (amount > 0) {
+            balance += amount;
+            log << "Deposit successful." << endl;
+        } else {
+            log << "Deposit amount must be positive." << endl;
+        }
+    }
+
+    bool withdraw(Amount amount) {
+        if (amount > 0 && amount <= balance) {
+            balance -= amount;
+            log << "Withdrawal successful." << endl;
+            return true;
+        }
+        log << "Withdrawal failed. Invalid amount or insufficient funds." << endl;
+        return false;
+    }
+};
+
+// Times each operation individually and prints p50/p99 in nanoseconds.
+template <typename Operation>
+void measureLatency(const string& label, int operations, Operation op) {
+    vector<int64_t> samples(operations);
+    for (int i = 0; i < operations; ++i) {
+        auto start = chrono::steady_clock::now();
+        op(i);
+        auto stop = chrono::steady_clock::now();
+        samples[i] = chrono::duration_cast<chrono::nanoseconds>(stop - start).count();
+    }
+    sort(samples.begin(), samples.end());
+    cout << "  " << label << " p50 " << samples[operations / 2] << " ns, p99 " << samples[operations * 99 / 100]
+         << " ns" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    {
+        RingBufferSink console(cout);
+        BankAccount myAccount(100'000, &console);
+        myAccount.deposit(50'000);
+        TxStatus status = myAccount.withdraw(500'000);
+        if (status == TxStatus::InsufficientFunds) {
+            myAccount.withdraw(20'000);
+        }
+    } // the sink's destructor flushes the queued messages here
+    cout << endl;
+
+    // Usage: ./a.out [operations]
+    int n = argc > 1 ? stoi(argv[1]) : 200'000;
+    ofstream devNull("/dev/null");
+
+    cout << "Per-operation latency over " << n << " operations (alternating deposit/withdraw)" << endl;
+
+    LoggingBankAccount before(1'000'000, devNull);
+    measureLatency("before: cout/endl per call  ", n, [&](int i) {
+        if (i & 1) before.withdraw(300); else before.deposit(200);
+    });
+
+    BankAccount silent(1'000'000);
+    measureLatency("after:  status only, no sink", n, [&](int i) {
+        if (i & 1) silent.withdraw(300); else silent.deposit(200);
+    });
+
+    RingBufferSink queued(devNull);
+    BankAccount withSink(1'000'000, &queued);
+    measureLatency("after:  ring-buffer sink    ", n, [&](int i) {
+        if (i & 1) withSink.withdraw(300); else withSink.deposit(200);
+    });
+    cout << "  events dropped by full ring: " << queued.droppedCount() << endl;
+
+    return 0;
+}
@@ -0,0 +1,365 @@
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <fcntl.h>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+using namespace std;
+
+using Amount = int64_t; // whole cents, as in 3_fixed_point_money.cpp
+
+// One fixed-size, binary log record per successful deposit or withdrawal.
+// The checksum lets replay detect a record that was only half written when
+// the process died.
+struct LogRecord {
+    uint32_t accountId;
+    uint8_t kind; // 0 = deposit, 1 = withdrawal
+    uint8_t padding[3];
+    Amount amount;
+    uint64_t checksum;
+
+    uint64_t computeChecksum() const {
+        // FNV-1a over everything before the checksum field.
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(this);
+        uint64_t h = 1469598103934665603ull;
+        for (size_t i = 0; i < offsetof(LogRecord, checksum); ++i) {
+            h = (h ^ p[i]) * 1099511628211ull;
+        }
+        return h;
+    }
+};
+static_assert(sizeof(LogRecord) == 24, "on-disk layout must stay fixed");
+
+// Append-only write-ahead log with group commit. Records are buffered in
+// memory and written + fdatasync'ed together once either 'maxBatch' records
+// are pending or 'maxDelay' has passed since the oldest pending record.
+// One fsync then pays for the whole group instead of for each transaction.
+// A background flusher enforces the time window, so pending records reach
+// disk within 'maxDelay' even if no further append arrives.
+class WriteAheadLog {
+private:
+    int fd;
+    size_t maxBatch;
+    chrono::microseconds maxDelay;
+
+    mutex lock; // guards everything below except 'writing'
+    condition_variable wake, committed;
+    vector<LogRecord> pending;
+    chrono::steady_clock::time_point oldestPending;
+    uint64_t appended = 0, durable = 0;
+    size_t commits = 0;
+    bool stopping = false;
+    exception_ptr failure;
+
+    mutex ioLock; // one group is written at a time, in order
+    vector<LogRecord> writing;
+    thread flusher;
+
+    void flushLoop() {
+        unique_lock<mutex> guard(lock);
+        while (!stopping) {
+            if (pending.empty()) {
+                wake.wait(guard);
+            } else if (chrono::steady_clock::now() < oldestPending + maxDelay) {
+                wake.wait_until(guard, oldestPending + maxDelay);
+            } else {
+                guard.unlock();
+                try {
+                    commit();
+                } catch (...) {
+                    return; // commit() has recorded the failure
+                }
+                guard.lock();
+            }
+        }
+    }
+
+    void throwIfFailed() {
+        if (failure) {
+            rethrow_exception(failure);
+        }
+    }
+
+public:
+    // Opens 'path' for appending. Run recover() on it first so that new
+    // records never land behind a torn tail.
+    WriteAheadLog(const string& path, size_t groupSize, chrono::microseconds groupWindow)
+        : maxBatch(groupSize), maxDelay(groupWindow) {
+        fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (fd < 0) {
+            throw runtime_error("WriteAheadLog: cannot open " + path);
+        }
+        pending.reserve(groupSize);
+        writing.reserve(groupSize);
+        flusher = thread([this] { flushLoop(); });
+    }
+
+    WriteAheadLog(const WriteAheadLog&) = delete;
+    WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+    // Queues a record and returns its sequence number; see waitDurable().
+    uint64_t append(uint32_t accountId, uint8_t kind, Amount amount) {
+        LogRecord r{accountId, kind, {0, 0, 0}, amount, 0};
+        r.checksum = r.computeChecksum();
+        uint64_t sequence;
+        bool full;
+        {
+            lock_guard<mutex> guard(lock);
+            throwIfFailed();
+            if (pending.empty()) {
+                oldestPending = chrono::steady_clock::now();
+                wake.notify_one(); // start the flusher's clock
+            }
+            pending.push_back(r);
+            sequence = ++appended;
+            full = pending.size() >= maxBatch;
+        }
+        if (full) {
+            commit();
+        }
+        return sequence;
+    }
+
+    // Makes every appended record durable.
+    void commit() {
+        lock_guard<mutex> io(ioLock);
+        uint64_t upTo;
+        {
+            lock_guard<mutex> guard(lock);
+            throwIfFailed();
+            writing.swap(pending);
+            upTo = appended;
+        }
+        if (writing.empty()) {
+            return;
+        }
+        try {
+            const char* data = reinterpret_cast<const char*>(writing.data());
+            size_t left = writing.size() * sizeof(LogRecord);
+            while (left > 0) {
+                ssize_t written = ::write(fd, data, left);
+                if (written < 0) {
+                    throw runtime_error("WriteAheadLog: write failed");
+                }
+                data += written;
+                left -= size_t(written);
+            }
+            if (::fdatasync(fd) != 0) {
+                throw runtime_error("WriteAheadLog: fdatasync failed");
+            }
+        } catch (...) {
+            // A failed group leaves the log in an unknown state; refuse all
+            // further appends rather than pretend later ones are durable.
+            lock_guard<mutex> guard(lock);
+            failure = current_exception();
+            committed.notify_all();
+            throw;
+        }
+        writing.clear();
+        {
+            lock_guard<mutex> guard(lock);
+            durable = upTo;
+            ++commits;
+        }
+        committed.notify_all();
+    }
+
+    // Blocks until the record with this sequence number is on disk.
+    void waitDurable(uint64_t sequence) {
+        unique_lock<mutex> guard(lock);
+        committed.wait(guard, [&] { return durable >= sequence || failure; });
+        throwIfFailed();
+    }
+
+    size_t commitCount() {
+        lock_guard<mutex> guard(lock);
+        return commits;
+    }
+
+    // Commits what is still pending on a best-effort basis; a write error
+    // here cannot be reported, so call commit() first to be sure.
+    ~WriteAheadLog() {
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_one();
+        flusher.join();
+        try {
+            commit();
+        } catch (...) {
+            // already recorded in 'failure'; nothing more a destructor can do
+        }
+        ::close(fd);
+    }
+
+    // Reads the log from the start and hands every intact record to 'apply'.
+    // Stops at the first torn or corrupt record. Returns the length in bytes
+    // of the intact prefix.
+    template <typename Apply>
+    static uint64_t replay(const string& path, Apply apply) {
+        int in = ::open(path.c_str(), O_RDONLY);
+        if (in < 0) {
+            return 0; // no log yet: nothing to recover
+        }
+        uint64_t validBytes = 0;
+        vector<LogRecord> chunk(4096);
+        bool intact = true;
+        while (intact) {
+            ssize_t got = ::read(in, chunk.data(), chunk.size() * sizeof(LogRecord));
+            if (got <= 0) {
+                break;
+            }
+            size_t records = size_t(got) / sizeof(LogRecord);
+            for (size_t i = 0; i < records; ++i) {
+                if (chunk[i].checksum != chunk[i].computeChecksum()) {
+                    intact = false;
+                    break;
+                }
+                apply(chunk[i]);
+                validBytes += sizeof(LogRecord);
+            }
+            if (size_t(got) % sizeof(LogRecord) != 0) {
+                break; // torn tail
+            }
+        }
+        ::close(in);
+        return validBytes;
+    }
+
+    // Replays the log, then cuts off anything after the last intact record so
+    // the next writer appends directly behind it. Returns the record count.
+    template <typename Apply>
+    static size_t recover(const string& path, Apply apply) {
+        uint64_t validBytes = replay(path, apply);
+        struct stat st;
+        if (::stat(path.c_str(), &st) == 0 && uint64_t(st.st_size) > validBytes) {
+            if (::truncate(path.c_str(), off_t(validBytes)) != 0) {
+                throw runtime_error("WriteAheadLog: cannot truncate torn tail of " + path);
+            }
+        }
+        return size_t(validBytes / sizeof(LogRecord));
+    }
+};
+
+// A set of accounts whose every successful change is appended to the log
+// before the call returns. The change is durable once its group commits:
+// within the group window, or as soon as sync() returns. Balances live in
+// memory; the log is the source of truth on restart.
+class DurableBank {
+private:
+    vector<Amount> balances;
+    WriteAheadLog log;
+
+    static vector<Amount> recoverBalances(const string& logPath, size_t accounts) {
+        vector<Amount> recovered(accounts, 0);
+        WriteAheadLog::recover(logPath, [&](const LogRecord& r) {
+            if (r.accountId >= recovered.size()) {
+                recovered.resize(r.accountId + 1, 0);
+            }
+            recovered[r.accountId] += r.kind == 0 ? r.amount : -r.amount;
+        });
+        return recovered;
+    }
+
+public:
+    // Recovery runs before the log is opened for appending (members are
+    // initialised in declaration order).
+    DurableBank(const string& logPath, size_t accounts, size_t groupSize, chrono::microseconds groupWindow)
+        : balances(recoverBalances(logPath, accounts)), log(logPath, groupSize, groupWindow) {}
+
+    // Unknown account ids are refused before anything is logged.
+    bool deposit(uint32_t id, Amount amount) {
+        if (id >= balances.size() || amount <= 0) {
+            return false;
+        }
+        log.append(id, 0, amount);
+        balances[id] += amount;
+        return true;
+    }
+
+    bool withdraw(uint32_t id, Amount amount) {
+        if (id >= balances.size() || amount <= 0 || amount > balances[id]) {
+            return false;
+        }
+        log.append(id, 1, amount);
+        balances[id] -= amount;
+        return true;
+    }
+
+    Amount getBalance(uint32_t id) const { return balances.at(id); }
+
+    void sync() { log.commit(); }
+    size_t commitCount() { return log.commitCount(); }
+};
+
+int main(int argc, char* argv[]) {
+    // Usage: ./a.out [logDirectory] [transactions]
+    string dir = argc > 1 ? argv[1] : "/tmp";
+    int n = argc > 2 ? stoi(argv[2]) : 20'000;
+    string demoPath = dir + "/bank_demo.wal";
+    ::unlink(demoPath.c_str());
+
+    {
+        DurableBank bank(demoPath, 2, 64, chrono::milliseconds(5));
+        bank.deposit(0, 100'000);
+        bank.deposit(1, 5'000);
+        bank.withdraw(0, 20'000);
+        bank.withdraw(1, 9'000); // rejected, so never logged
+        bank.deposit(7, 1'000);  // no such account: rejected, never logged
+        cout << "Before restart: " << bank.getBalance(0) << " / " << bank.getBalance(1) << " cents" << endl;
+    } // destructor commits what is still pending
+
+    {
+        DurableBank recovered(demoPath, 2, 64, chrono::milliseconds(5));
+        cout << "After replay:   " << recovered.getBalance(0) << " / " << recovered.getBalance(1) << " cents" << endl;
+    }
+
+    // Crash in the middle of writing a record, restart, keep going, restart.
+    {
+        int fd = ::open(demoPath.c_str(), O_WRONLY | O_APPEND);
+        LogRecord torn{0, 0, {0, 0, 0}, 777, 0};
+        if (::write(fd, &torn, sizeof(torn) / 2) < 0) {
+            throw runtime_error("cannot simulate torn write");
+        }
+        ::close(fd);
+    }
+    {
+        DurableBank afterCrash(demoPath, 2, 64, chrono::milliseconds(5));
+        afterCrash.deposit(1, 5'000);
+        this_thread::sleep_for(chrono::milliseconds(20)); // idle: the flusher commits the group
+        cout << "After crash:    " << afterCrash.getBalance(0) << " / " << afterCrash.getBalance(1) << " cents ("
+             << afterCrash.commitCount() << " commit while idle)" << endl;
+    }
+    {
+        DurableBank recovered(demoPath, 2, 64, chrono::milliseconds(5));
+        cout << "After replay:   " << recovered.getBalance(0) << " / " << recovered.getBalance(1) << " cents" << endl;
+    }
+
+    cout << "\nGroup size  commits  transactions/sec  (" << n << " transactions, 5 ms window)" << endl;
+    for (size_t group : {1, 16, 256, 4096}) {
+        string path = dir + "/bank_bench.wal";
+        ::unlink(path.c_str());
+        DurableBank bank(path, 1024, group, chrono::milliseconds(5));
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < n; ++i) {
+            bank.deposit(uint32_t(i % 1024), 100 + i % 50);
+        }
+        bank.sync();
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        cout << group << "\t    " << bank.commitCount() << "\t     " << n / elapsed.count() << endl;
+        ::unlink(path.c_str());
+    }
+    ::unlink(demoPath.c_str());
+
+    return 0;
+}
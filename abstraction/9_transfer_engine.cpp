@@ -0,0 +1,228 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+using Amount = int64_t; // whole cents, as in 3_fixed_point_money.cpp
+
+enum class TransferStatus : uint8_t {
+    Ok,
+    InvalidAmount,
+    InsufficientFunds,
+};
+
+// Strategy 1: one mutex per account, always locked in ascending id order.
+// Two transfers A->B and B->A both lock min(A,B) first, so no cycle of
+// waiting threads -- and therefore no deadlock -- can form.
+class OrderedLockingEngine {
+private:
+    struct alignas(64) Account {
+        mutex lock;
+        Amount balance = 0;
+    };
+    vector<Account> accounts;
+    atomic<uint64_t> contended{0}; // times the first try_lock failed
+
+    void lockCounted(mutex& m) {
+        if (!m.try_lock()) {
+            contended.fetch_add(1, memory_order_relaxed);
+            m.lock();
+        }
+    }
+
+public:
+    OrderedLockingEngine(size_t count, Amount initialBalance) : accounts(count) {
+        for (Account& a : accounts) {
+            a.balance = initialBalance;
+        }
+    }
+
+    TransferStatus transfer(uint32_t from, uint32_t to, Amount amount) {
+        if (amount <= 0 || from == to) {
+            return TransferStatus::InvalidAmount;
+        }
+        Account& first = accounts[min(from, to)];
+        Account& second = accounts[max(from, to)];
+        lockCounted(first.lock);
+        lockCounted(second.lock);
+        TransferStatus status = TransferStatus::InsufficientFunds;
+        if (accounts[from].balance >= amount) {
+            accounts[from].balance -= amount;
+            accounts[to].balance += amount;
+            status = TransferStatus::Ok;
+        }
+        second.lock.unlock();
+        first.lock.unlock();
+        return status;
+    }
+
+    Amount totalBalance() {
+        Amount total = 0;
+        for (Account& a : accounts) {
+            lock_guard<mutex> guard(a.lock);
+            total += a.balance;
+        }
+        return total;
+    }
+
+    uint64_t retries() const { return contended.load(); }
+};
+
+// Strategy 2: optimistic versioning. Each account carries a version number
+// that is odd while someone is writing it. A transfer reads both versions and
+// the source balance without locking, then claims each account with a CAS
+// that succeeds only if its version is unchanged. If either claim fails the
+// transfer releases what it holds and retries, so a thread never waits while
+// holding an account and deadlock is impossible.
+class OptimisticEngine {
+private:
+    struct alignas(64) Account {
+        atomic<uint64_t> version{0};
+        atomic<Amount> balance{0};
+    };
+    vector<Account> accounts;
+    atomic<uint64_t> aborts{0};
+
+    bool claim(Account& a, uint64_t expected) {
+        return (expected & 1) == 0 &&
+               a.version.compare_exchange_strong(expected, expected + 1, memory_order_acquire);
+    }
+
+    void release(Account& a) { a.version.fetch_add(1, memory_order_release); }
+
+public:
+    OptimisticEngine(size_t count, Amount initialBalance) : accounts(count) {
+        for (Account& a : accounts) {
+            a.balance.store(initialBalance, memory_order_relaxed);
+        }
+    }
+
+    TransferStatus transfer(uint32_t from, uint32_t to, Amount amount) {
+        if (amount <= 0 || from == to) {
+            return TransferStatus::InvalidAmount;
+        }
+        Account& src = accounts[from];
+        Account& dst = accounts[to];
+        for (;;) {
+            uint64_t vs = src.version.load(memory_order_acquire);
+            uint64_t vd = dst.version.load(memory_order_acquire);
+            Amount available = src.balance.load(memory_order_relaxed);
+            if (available < amount && vs == src.version.load(memory_order_acquire) && (vs & 1) == 0) {
+                return TransferStatus::InsufficientFunds; // consistent read, nothing to do
+            }
+            if (claim(src, vs)) {
+                if (claim(dst, vd)) {
+                    TransferStatus status = TransferStatus::InsufficientFunds;
+                    if (src.balance.load(memory_order_relaxed) >= amount) {
+                        src.balance.fetch_sub(amount, memory_order_relaxed);
+                        dst.balance.fetch_add(amount, memory_order_relaxed);
+                        status = TransferStatus::Ok;
+                    }
+                    release(dst);
+                    release(src);
+                    return status;
+                }
+                release(src);
+            }
+            aborts.fetch_add(1, memory_order_relaxed);
+            this_thread::yield();
+        }
+    }
+
+    Amount totalBalance() const {
+        Amount total = 0;
+        for (const Account& a : accounts) {
+            total += a.balance.load();
+        }
+        return total;
+    }
+
+    uint64_t retries() const { return aborts.load(); }
+};
+
+// Zipfian account picker: account k is chosen with probability proportional
+// to 1 / (k + 1)^skew, so a handful of "hot" accounts see most traffic.
+class ZipfianPicker {
+private:
+    vector<double> cdf;
+
+public:
+    ZipfianPicker(size_t accounts, double skew) : cdf(accounts) {
+        double sum = 0;
+        for (size_t k = 0; k < accounts; ++k) {
+            sum += 1.0 / pow(double(k + 1), skew);
+            cdf[k] = sum;
+        }
+        for (double& c : cdf) {
+            c /= sum;
+        }
+    }
+
+    uint32_t pick(mt19937_64& rng) const {
+        double u = uniform_real_distribution<double>(0.0, 1.0)(rng);
+        return uint32_t(min<size_t>(lower_bound(cdf.begin(), cdf.end(), u) - cdf.begin(), cdf.size() - 1));
+    }
+};
+
+template <typename Engine>
+void runBenchmark(const string& label, int threads, size_t accounts, int transfersPerThread,
+                  const ZipfianPicker& picker) {
+    const Amount initial = 100'000;
+    Engine engine(accounts, initial);
+    vector<thread> workers;
+    atomic<uint64_t> ok{0};
+
+    auto start = chrono::steady_clock::now();
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            mt19937_64 rng(1234 + t);
+            uint64_t done = 0;
+            for (int i = 0; i < transfersPerThread; ++i) {
+                uint32_t from = picker.pick(rng);
+                uint32_t to = picker.pick(rng);
+                done += engine.transfer(from, to, 1 + Amount(rng() % 500)) == TransferStatus::Ok;
+            }
+            ok.fetch_add(done);
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    double attempts = double(threads) * transfersPerThread;
+    bool conserved = engine.totalBalance() == Amount(accounts) * initial;
+    cout << "  " << label << " threads " << threads << ": " << attempts / elapsed.count() / 1e6 << " M transfers/s, "
+         << 100.0 * double(engine.retries()) / attempts << "% retry/contention, " << ok.load() << " ok"
+         << (conserved ? "" : "  !! money not conserved") << endl;
+}
+
+int main(int argc, char* argv[]) {
+    OrderedLockingEngine demo(2, 10'000);
+    cout << "A -> B 2500: " << (demo.transfer(0, 1, 2'500) == TransferStatus::Ok ? "ok" : "rejected") << endl;
+    cout << "B -> A 90000: "
+         << (demo.transfer(1, 0, 90'000) == TransferStatus::InsufficientFunds ? "insufficient funds" : "ok") << endl;
+
+    // Usage: ./a.out [maxThreads] [accounts] [transfersPerThread] [skew]
+    int maxThreads = argc > 1 ? stoi(argv[1]) : int(max(2u, thread::hardware_concurrency()));
+    size_t accounts = argc > 2 ? stoull(argv[2]) : 100'000;
+    int perThread = argc > 3 ? stoi(argv[3]) : 500'000;
+    double skew = argc > 4 ? stod(argv[4]) : 0.99;
+    ZipfianPicker picker(accounts, skew);
+
+    cout << "\nZipfian(" << skew << ") transfers over " << accounts << " accounts" << endl;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        runBenchmark<OrderedLockingEngine>("ordered locks", threads, accounts, perThread, picker);
+        runBenchmark<OptimisticEngine>("optimistic   ", threads, accounts, perThread, picker);
+    }
+
+    return 0;
+}